@@ -0,0 +1,53 @@
+#include "binarystream.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+
+/**
+ * @brief Push the written contents of a file out to the disk.
+ * @param file = The file to sync, its buffer is flushed first.
+ * @return True if sucessful.
+ */
+static bool syncFile(std::FILE* file)
+{
+    if (std::fflush(file) != 0)
+        return false;
+
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+bool writeFileAtomic(const std::string& filePath, const char* data, std::size_t size)
+{
+    const std::string tempPath = filePath + ".tmp";
+
+    std::FILE* file = std::fopen(tempPath.c_str(), "wb");
+
+    if (!file)
+        return false;
+
+    // The temp file has to be on the disk before it replaces the old one, or a power loss
+    // right after the rename could leave an empty file behind.
+    const bool written = std::fwrite(data, 1, size, file) == size && syncFile(file);
+
+    if (std::fclose(file) != 0 || !written) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    // The old file is replaced in one step, so there is always either the old or the new file.
+#ifdef _WIN32
+    return MoveFileExA(tempPath.c_str(), filePath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(tempPath.c_str(), filePath.c_str()) == 0;
+#endif
+}
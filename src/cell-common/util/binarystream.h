@@ -0,0 +1,204 @@
+#ifndef BINARYSTREAM_H_INCLUDE
+#define BINARYSTREAM_H_INCLUDE
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Appends plain values and arrays to a byte buffer in the byte order of the machine.
+ */
+class BinaryWriter
+{
+public:
+
+    /**
+     * @brief Create a writer that appends to a buffer.
+     * @param buffer = The buffer to append to.
+     */
+    explicit BinaryWriter(std::vector<char>& buffer) :
+        mBuffer(buffer)
+    { }
+
+    /**
+     * @brief Append a plain value.
+     * @param value = The value to append.
+     */
+    template <typename T>
+    void write(const T& value)
+    {
+        writeBytes(&value, sizeof(T));
+    }
+
+    /**
+     * @brief Append the contents of an array, the length is not written.
+     * @param values = The array to append.
+     */
+    template <typename T>
+    void writeArray(const std::vector<T>& values)
+    {
+        if (!values.empty())
+            writeBytes(values.data(), values.size() * sizeof(T));
+    }
+
+    /**
+     * @brief Append raw bytes.
+     * @param data = The bytes to append.
+     * @param size = The number of bytes.
+     */
+    void writeBytes(const void* data, std::size_t size)
+    {
+        const std::size_t offset = mBuffer.size();
+        mBuffer.resize(offset + size);
+        std::memcpy(&mBuffer[offset], data, size);
+    }
+
+private:
+
+    /**
+     * @brief The buffer being appended to.
+     */
+    std::vector<char>& mBuffer;
+};
+
+/**
+ * @brief Reads plain values and arrays back out of a block of memory written by a BinaryWriter.
+ * Every read is bounds checked, once a read fails every following read fails too.
+ */
+class BinaryReader
+{
+public:
+
+    /**
+     * @brief Create a reader over a block of memory.
+     * @param data = The start of the memory.
+     * @param size = The size of the memory in bytes.
+     */
+    BinaryReader(const char* data, std::size_t size) :
+        mData(data),
+        mSize(size),
+        mOffset(0),
+        mFailed(false)
+    { }
+
+    /**
+     * @brief Read a plain value.
+     * @param value = The value to read into.
+     * @return True if there was enough data left.
+     */
+    template <typename T>
+    bool read(T& value)
+    {
+        return readBytes(&value, sizeof(T));
+    }
+
+    /**
+     * @brief Read an array of a known length.
+     * @param values = The array to read into, it is resized to the length.
+     * @param count = The number of values to read.
+     * @return True if there was enough data left.
+     */
+    template <typename T>
+    bool readArray(std::vector<T>& values, std::size_t count)
+    {
+        if (!canRead(count, sizeof(T)))
+            return false;
+
+        values.resize(count);
+
+        return count == 0 || readBytes(values.data(), count * sizeof(T));
+    }
+
+    /**
+     * @brief Read raw bytes.
+     * @param data = The memory to read into.
+     * @param size = The number of bytes.
+     * @return True if there was enough data left.
+     */
+    bool readBytes(void* data, std::size_t size)
+    {
+        if (!canRead(size, 1))
+            return false;
+
+        std::memcpy(data, mData + mOffset, size);
+        mOffset += size;
+
+        return true;
+    }
+
+    /**
+     * @brief Skip over some bytes and get a pointer to them, used to read data in place.
+     * @param size = The number of bytes.
+     * @return A pointer to the bytes, or null if there was not enough data left.
+     */
+    const char* skip(std::size_t size)
+    {
+        if (!canRead(size, 1))
+            return 0;
+
+        const char* data = mData + mOffset;
+        mOffset += size;
+
+        return data;
+    }
+
+    /**
+     * @brief Check if a read has failed.
+     * @return True if a read ran past the end of the data.
+     */
+    bool hasFailed() const { return mFailed; }
+
+    /**
+     * @brief Get the number of bytes that have not been read yet.
+     * @return The remaining byte count.
+     */
+    std::size_t getRemaining() const { return mSize - mOffset; }
+
+private:
+
+    /**
+     * @brief The start of the memory.
+     */
+    const char* mData;
+
+    /**
+     * @brief The size of the memory.
+     */
+    std::size_t mSize;
+
+    /**
+     * @brief The number of bytes read so far.
+     */
+    std::size_t mOffset;
+
+    /**
+     * @brief Set once a read has run past the end.
+     */
+    bool mFailed;
+
+    /**
+     * @brief Check if there is room for count values of a size, without overflowing.
+     * @param count = The number of values.
+     * @param size = The size of each value.
+     * @return True if the values fit in the remaining data.
+     */
+    bool canRead(std::size_t count, std::size_t size)
+    {
+        if (mFailed || (size != 0 && count > getRemaining() / size))
+            mFailed = true;
+
+        return !mFailed;
+    }
+};
+
+/**
+ * @brief Write a buffer to a file, going through a temporary file so a crash never leaves half a file.
+ * @param filePath = The path of the file to write.
+ * @param data = The bytes to write.
+ * @param size = The number of bytes.
+ * @return True if sucessful.
+ */
+bool writeFileAtomic(const std::string& filePath, const char* data, std::size_t size);
+
+#endif // BINARYSTREAM_H_INCLUDE
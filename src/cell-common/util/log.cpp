@@ -1,70 +1,363 @@
 #include "log.h"
-#include "timehelper.h"
+#include "profiler.h"
 
-#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 //Static decleration.
-std::ofstream Log::mFileStream;
 LogLevel Log::mLogLevel = LOG_LEVEL_DEBUG;
 
-bool Log::initialize(std::string logFilePath)
+static const ProfileZone LOG_ZONE = Profiler::addZone("log");
+
+// How long the writer thread sleeps when the queue is empty.
+static const std::chrono::milliseconds LOG_IDLE_WAIT(5);
+
+/**
+ * @brief The queue and the writer thread, made on first use so messages can be written from static initializers.
+ * The queue is a bounded multi producer, single consumer ring, each record carries a sequence number
+ * that says whether it is free for the producers or ready for the writer.
+ */
+struct LogState
 {
-    mFileStream.open(logFilePath.c_str(), std::ios::out | std::ios::app);
-    if (!mFileStream.is_open())
+    LogState() :
+        records(new LogRecord[LOG_QUEUE_SIZE]),
+        enqueuePosition(0),
+        dequeuePosition(0),
+        dropped(0),
+        reportedDrops(0),
+        running(false),
+        cachedSecond(-1)
     {
-        std::cout << "failed to open logger: " << logFilePath << std::endl;
-        return false;
+        for (unsigned int i = 0; i < LOG_QUEUE_SIZE; i++)
+            records[i].sequence.store(i, std::memory_order_relaxed);
     }
 
-    return true;
+    ~LogState()
+    {
+        // The program is exiting without destroying the log, stop the writer so it isn't left running.
+        if (writer.joinable()) {
+            running = false;
+            writer.join();
+        }
+
+        delete[] records;
+    }
+
+    LogRecord* records;
+
+    std::atomic<unsigned long long> enqueuePosition;
+    unsigned long long dequeuePosition;
+
+    std::atomic<unsigned long long> dropped;
+    unsigned long long reportedDrops;
+
+    std::atomic<bool> running;
+    std::thread writer;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+
+    // Only used by whoever is writing, the writer thread or the direct path.
+    std::mutex outputMutex;
+    std::ofstream file;
+    std::ostringstream line;
+    long long cachedSecond;
+    std::string cachedTimestamp;
+};
+
+static LogState& getState()
+{
+    static LogState state;
+    return state;
 }
 
-void Log::destroy()
+/**
+ * @brief The record used when the writer thread isn't running, the message is written as soon as it is filled in.
+ */
+static thread_local LogRecord scratchRecord;
+
+/**
+ * @brief Get the current system time.
+ * @return The nanoseconds since the epoch.
+ */
+static long long getSystemTime()
 {
-    if (mFileStream.is_open())
-    {
-        mFileStream.close();
+    const std::chrono::system_clock::duration now = std::chrono::system_clock::now().time_since_epoch();
+    return (long long)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+/**
+ * @brief Get the timestamp of a time, the string is only rebuilt once a second.
+ * @param state = The log state holding the cached timestamp.
+ * @param time = The system time in nanoseconds.
+ * @return The formatted time, YYYY-MM-DD HH:mm:ss.
+ */
+static const std::string& getTimestamp(LogState& state, long long time)
+{
+    const long long second = time / 1000000000LL;
+
+    if (second != state.cachedSecond) {
+
+        const time_t now = (time_t)second;
+        struct tm tstruct = *localtime(&now);
+
+        char buf[80];
+        strftime(buf, sizeof(buf), "%Y-%m-%d %X", &tstruct);
+
+        state.cachedSecond = second;
+        state.cachedTimestamp = buf;
     }
+
+    return state.cachedTimestamp;
 }
 
-void Log::message(std::string message)
+/**
+ * @brief Format a record into the line buffer of the log state.
+ * @param state = The log state.
+ * @param record = The record to format.
+ */
+static void formatRecord(LogState& state, const LogRecord& record)
 {
-    std::cout << "[" << currentDateTime() << "] "  << message << std::endl;
-    if (mFileStream.is_open())
-    {
-        mFileStream << "[" << currentDateTime() << "] "  << message << std::endl;
+    std::ostringstream& line = state.line;
+
+    line << "[" << getTimestamp(state, record.time) << "] ";
+
+    switch (record.level) {
+    case LOG_LEVEL_DEBUG: line << " [DEBUG] "; break;
+    case LOG_LEVEL_INFO: line << " [INFO] "; break;
+    case LOG_LEVEL_WARN: line << " [WARN] "; break;
+    case LOG_LEVEL_ERROR: line << " [ERROR] "; break;
+    default: break;
     }
+
+    for (unsigned int i = 0; i < record.argumentCount; i++) {
+
+        const LogArgument& argument = record.arguments[i];
+
+        switch (argument.type) {
+        case LogArgument::Bool: line << (argument.u ? "true" : "false"); break;
+        case LogArgument::Char: line << (char)argument.i; break;
+        case LogArgument::Int: line << argument.i; break;
+        case LogArgument::UInt: line << argument.u; break;
+        case LogArgument::Real: line << argument.d; break;
+        case LogArgument::Text: line.write(record.text + argument.text.offset, argument.text.length); break;
+        }
+    }
+
+    if (record.truncated)
+        line << "...";
+
+    line << '\n';
 }
 
-void Log::debug(std::string debug)
+/**
+ * @brief Write the formatted lines to the console and the log file and clear the line buffer.
+ * @param state = The log state.
+ */
+static void flushLines(LogState& state)
 {
-    if (mLogLevel >= LOG_LEVEL_DEBUG)
-    {
-        message(std::string(" [DEBUG] ").append(debug));
+    const std::string lines = state.line.str();
+    if (lines.empty())
+        return;
+
+    std::cout << lines;
+    std::cout.flush();
+
+    if (state.file.is_open()) {
+        state.file << lines;
+        state.file.flush();
     }
+
+    state.line.str(std::string());
 }
 
-void Log::info(std::string info)
+/**
+ * @brief Format and write every record that is ready.
+ * @param state = The log state.
+ * @return True if anything was written.
+ */
+static bool drainQueue(LogState& state)
 {
-    if (mLogLevel >= LOG_LEVEL_INFO)
-    {
-        message(std::string(" [INFO] ").append(info));
+    std::lock_guard<std::mutex> lock(state.outputMutex);
+
+    const unsigned long long start = Profiler::now();
+    bool wrote = false;
+
+    for (;;) {
+
+        LogRecord& record = state.records[state.dequeuePosition & (LOG_QUEUE_SIZE - 1)];
+        const unsigned long long sequence = record.sequence.load(std::memory_order_acquire);
+
+        // The producer hasn't finished this record yet, or the queue is empty.
+        if (sequence != state.dequeuePosition + 1)
+            break;
+
+        formatRecord(state, record);
+
+        // Hand the record back to the producers for their next lap around the ring.
+        record.sequence.store(state.dequeuePosition + LOG_QUEUE_SIZE, std::memory_order_release);
+        state.dequeuePosition++;
+
+        wrote = true;
+    }
+
+    const unsigned long long dropped = state.dropped.load(std::memory_order_relaxed);
+    if (dropped != state.reportedDrops) {
+        state.line << "[" << getTimestamp(state, getSystemTime()) << "]  [WARN] the log queue was full, dropped ";
+        state.line << (dropped - state.reportedDrops) << " messages\n";
+        state.reportedDrops = dropped;
+        wrote = true;
+    }
+
+    flushLines(state);
+
+    // Only the batches that wrote something are timed, the idle checks would drown them out.
+    if (wrote)
+        Profiler::record(LOG_ZONE, start, Profiler::now() - start);
+
+    return wrote;
+}
+
+/**
+ * @brief The writer thread, it writes the queued messages out in batches until the log is destroyed.
+ */
+static void runWriter()
+{
+    LogState& state = getState();
+
+    while (state.running.load(std::memory_order_acquire)) {
+
+        if (!drainQueue(state)) {
+            std::unique_lock<std::mutex> lock(state.wakeMutex);
+            state.wake.wait_for(lock, LOG_IDLE_WAIT);
+        }
     }
+
+    // Anything written before destroy() was called still goes out.
+    drainQueue(state);
 }
 
-void Log::warn(std::string warning)
+bool Log::initialize(std::string logFilePath)
 {
-    if (mLogLevel >= LOG_LEVEL_WARN)
+    LogState& state = getState();
+
+    if (state.running)
+        return false;
+
+    bool opened = false;
     {
-        message(std::string(" [WARN] ").append(warning));
+        std::lock_guard<std::mutex> lock(state.outputMutex);
+
+        state.file.open(logFilePath.c_str(), std::ios::out | std::ios::app);
+        opened = state.file.is_open();
+    }
+
+    // The console still gets the messages when there is no log file.
+    state.running = true;
+    state.writer = std::thread(runWriter);
+
+    if (!opened) {
+        error("failed to open logger: ", logFilePath);
+        return false;
     }
+
+    return true;
 }
 
-void Log::error(std::string error)
+void Log::destroy()
 {
-    if (mLogLevel >= LOG_LEVEL_ERROR)
+    LogState& state = getState();
+
+    if (state.running) {
+        state.running = false;
+        state.wake.notify_one();
+        state.writer.join();
+
+        // A message that was queued just as the writer stopped is written here, or by its own
+        // commit if that comes later still, the fence pairs with the one in commitRecord.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        drainQueue(state);
+    }
+
+    std::lock_guard<std::mutex> lock(state.outputMutex);
+
+    if (state.file.is_open())
     {
-        message(std::string(" [ERROR] ").append(error));
+        state.file.close();
     }
 }
+
+unsigned long long Log::getDroppedCount()
+{
+    return getState().dropped.load(std::memory_order_relaxed);
+}
+
+LogRecord* Log::beginRecord(LogLevel level)
+{
+    LogState& state = getState();
+
+    LogRecord* record = &scratchRecord;
+
+    if (state.running.load(std::memory_order_acquire)) {
+
+        unsigned long long position = state.enqueuePosition.load(std::memory_order_relaxed);
+
+        for (;;) {
+            LogRecord& slot = state.records[position & (LOG_QUEUE_SIZE - 1)];
+            const unsigned long long sequence = slot.sequence.load(std::memory_order_acquire);
+            const long long difference = (long long)(sequence - position);
+
+            if (difference == 0) {
+                // The slot is free on this lap, try to claim it.
+                if (state.enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    record = &slot;
+                    break;
+                }
+            }
+            else if (difference < 0) {
+                // The writer is a whole lap behind, drop the message rather than wait for it.
+                state.dropped.fetch_add(1, std::memory_order_relaxed);
+                return 0;
+            }
+            else {
+                position = state.enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        record->position = position;
+    }
+
+    record->time = getSystemTime();
+    record->level = level;
+    record->argumentCount = 0;
+    record->textLength = 0;
+    record->truncated = false;
+
+    return record;
+}
+
+void Log::commitRecord(LogRecord* record)
+{
+    if (record != &scratchRecord) {
+        record->sequence.store(record->position + 1, std::memory_order_release);
+
+        // The writer stopped after this record was claimed, nothing else will write it out.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!getState().running.load(std::memory_order_relaxed))
+            drainQueue(getState());
+
+        return;
+    }
+
+    // There is no writer thread, write the message now.
+    ProfileScope zone(LOG_ZONE);
+
+    LogState& state = getState();
+    std::lock_guard<std::mutex> lock(state.outputMutex);
+
+    formatRecord(state, *record);
+    flushLines(state);
+}
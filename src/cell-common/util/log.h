@@ -1,6 +1,8 @@
 #ifndef LOG_H_INCLUDE
 #define LOG_H_INCLUDE
 
+#include <atomic>
+#include <cstring>
 #include <string>
 #include <sstream>
 #include <fstream>
@@ -11,54 +13,163 @@ static const LogLevel LOG_LEVEL_INFO = 2;
 static const LogLevel LOG_LEVEL_WARN = 1;
 static const LogLevel LOG_LEVEL_ERROR = 0;
 
+/**
+ * @brief The level of the messages written with Log::message, they are never filtered or tagged.
+ */
+static const LogLevel LOG_LEVEL_NONE = -1;
+
+/**
+ * @brief The number of messages the log can hold before the writer thread catches up, a power of two.
+ */
+static const unsigned int LOG_QUEUE_SIZE = 4096;
+
+/**
+ * @brief The most values one message can be made of.
+ */
+static const unsigned int LOG_MAX_ARGUMENTS = 12;
+
+/**
+ * @brief The space for the text values of one message, longer text is cut short.
+ */
+static const unsigned int LOG_TEXT_SIZE = 480;
+
+/**
+ * @brief One value of a log message, stored as it was given and only formatted by the writer thread.
+ */
+struct LogArgument
+{
+    enum Type : unsigned char
+    {
+        Bool,
+        Char,
+        Int,
+        UInt,
+        Real,
+        Text
+    };
+
+    Type type;
+
+    union
+    {
+        long long i;
+        unsigned long long u;
+        double d;
+        struct
+        {
+            unsigned short offset;
+            unsigned short length;
+        } text;
+    };
+};
+
+/**
+ * @brief A log message waiting in the queue for the writer thread.
+ */
+struct LogRecord
+{
+    /**
+     * @brief Tells the producers and the writer which turn the record is on.
+     */
+    std::atomic<unsigned long long> sequence;
+
+    /**
+     * @brief The queue position the record was claimed for.
+     */
+    unsigned long long position;
+
+    /**
+     * @brief The system time the message was written at, in nanoseconds.
+     */
+    long long time;
+
+    LogLevel level;
+    unsigned int argumentCount;
+    unsigned int textLength;
+    bool truncated;
+
+    LogArgument arguments[LOG_MAX_ARGUMENTS];
+    char text[LOG_TEXT_SIZE];
+};
+
 /**
  * @brief This class is used to write time stamped log messages.
+ * A message is made of any number of text and number values, which are copied into a lock free queue
+ * and formatted and written by a background thread, so logging never waits on the console or the disk.
+ * The level is checked before anything is copied. When the writer thread isn't running, before
+ * initialize() and after destroy(), the messages are written straight away instead. A message
+ * queued while destroy() is stopping the writer is written by destroy() or by the thread that
+ * queued it, to the console only if the log file has been closed by then.
  */
 class Log
 {
 public:
 
     /**
-     * @brief Initialize the log file.
+     * @brief Initialize the log file and start the writer thread.
      * @param logFile = The file path to log to.
      * @return True if sucessful.
      */
     static bool initialize(std::string logFile);
 
     /**
-     * @brief Destroy the log file closeing the open resources.
+     * @brief Write out the queued messages, stop the writer thread and close the log file.
      */
     static void destroy();
 
     /**
-     * @brief Write a message to the log.
-     * @param message = The message to write.
+     * @brief Write a message to the log without a level.
+     * @param args = The values the message is made of.
      */
-    static void message(std::string message);
+    template <typename... Args>
+    static void message(const Args&... args)
+    {
+        write(LOG_LEVEL_NONE, args...);
+    }
 
     /**
      * @brief Write a debug message to the log.
-     * @param debug = The debug message.
+     * @param args = The values the message is made of.
      */
-    static void debug(std::string debug);
+    template <typename... Args>
+    static void debug(const Args&... args)
+    {
+        if (mLogLevel >= LOG_LEVEL_DEBUG)
+            write(LOG_LEVEL_DEBUG, args...);
+    }
 
     /**
      * @brief Write an info message to the log.
-     * @param info = The info message.
+     * @param args = The values the message is made of.
      */
-    static void info(std::string info);
+    template <typename... Args>
+    static void info(const Args&... args)
+    {
+        if (mLogLevel >= LOG_LEVEL_INFO)
+            write(LOG_LEVEL_INFO, args...);
+    }
 
     /**
      * @brief Write a warning message to the log.
-     * @param warning = The warning message.
+     * @param args = The values the message is made of.
      */
-    static void warn(std::string warning);
+    template <typename... Args>
+    static void warn(const Args&... args)
+    {
+        if (mLogLevel >= LOG_LEVEL_WARN)
+            write(LOG_LEVEL_WARN, args...);
+    }
 
     /**
      * @brief Write an error to the log.
-     * @param error = The error message.
+     * @param args = The values the message is made of.
      */
-    static void error(std::string error);
+    template <typename... Args>
+    static void error(const Args&... args)
+    {
+        if (mLogLevel >= LOG_LEVEL_ERROR)
+            write(LOG_LEVEL_ERROR, args...);
+    }
 
     /**
      * @brief Set the log level filter level.
@@ -72,15 +183,114 @@ public:
      */
     static LogLevel getLogLevel() { return mLogLevel; }
 
+    /**
+     * @brief Get the number of messages dropped because the queue was full.
+     * @return The dropped message count.
+     */
+    static unsigned long long getDroppedCount();
+
 private:
 
     /**
-     * @brief mFileStream
+     * @brief Copy the values of a message into a record and queue it.
+     * @param level = The level of the message.
+     * @param args = The values the message is made of.
+     */
+    template <typename... Args>
+    static void write(LogLevel level, const Args&... args)
+    {
+        LogRecord* record = beginRecord(level);
+        if (!record)
+            return;
+
+        // Expands to one add() per value, in order.
+        int expand[] = { 0, (add(*record, args), 0)... };
+        (void)expand;
+
+        commitRecord(record);
+    }
+
+    /**
+     * @brief Claim a record in the queue, or the scratch record of the thread if the writer isn't running.
+     * @param level = The level of the message.
+     * @return The record to fill in, null if the queue is full.
+     */
+    static LogRecord* beginRecord(LogLevel level);
+
+    /**
+     * @brief Hand a filled in record to the writer thread, or write it now if it is the scratch record.
+     * @param record = The record from beginRecord().
      */
-    static std::ofstream mFileStream;
+    static void commitRecord(LogRecord* record);
+
+    /**
+     * @brief Claim the next argument slot of a record.
+     * @param record = The record to add to.
+     * @param type = The type of the argument.
+     * @return The argument, null if the record has no slots left.
+     */
+    static LogArgument* nextArgument(LogRecord& record, LogArgument::Type type)
+    {
+        if (record.argumentCount >= LOG_MAX_ARGUMENTS) {
+            record.truncated = true;
+            return 0;
+        }
+
+        LogArgument* argument = &record.arguments[record.argumentCount++];
+        argument->type = type;
+        return argument;
+    }
+
+    /**
+     * @brief Copy text into a record, cutting it short if the record is full.
+     * @param record = The record to add to.
+     * @param text = The text to copy.
+     * @param length = The length of the text.
+     */
+    static void addText(LogRecord& record, const char* text, std::size_t length)
+    {
+        LogArgument* argument = nextArgument(record, LogArgument::Text);
+        if (!argument)
+            return;
+
+        const std::size_t space = LOG_TEXT_SIZE - record.textLength;
+        if (length > space) {
+            length = space;
+            record.truncated = true;
+        }
+
+        std::memcpy(record.text + record.textLength, text, length);
+        argument->text.offset = (unsigned short)record.textLength;
+        argument->text.length = (unsigned short)length;
+        record.textLength += (unsigned int)length;
+    }
+
+    static void add(LogRecord& record, const std::string& value) { addText(record, value.data(), value.size()); }
+    static void add(LogRecord& record, const char* value) { addText(record, value ? value : "(null)", value ? std::strlen(value) : 6); }
+
+    static void add(LogRecord& record, bool value) { if (LogArgument* a = nextArgument(record, LogArgument::Bool)) a->u = value; }
+    static void add(LogRecord& record, char value) { if (LogArgument* a = nextArgument(record, LogArgument::Char)) a->i = value; }
+
+    static void add(LogRecord& record, signed char value) { addSigned(record, value); }
+    static void add(LogRecord& record, short value) { addSigned(record, value); }
+    static void add(LogRecord& record, int value) { addSigned(record, value); }
+    static void add(LogRecord& record, long value) { addSigned(record, value); }
+    static void add(LogRecord& record, long long value) { addSigned(record, value); }
+
+    static void add(LogRecord& record, unsigned char value) { addUnsigned(record, value); }
+    static void add(LogRecord& record, unsigned short value) { addUnsigned(record, value); }
+    static void add(LogRecord& record, unsigned int value) { addUnsigned(record, value); }
+    static void add(LogRecord& record, unsigned long value) { addUnsigned(record, value); }
+    static void add(LogRecord& record, unsigned long long value) { addUnsigned(record, value); }
+
+    static void add(LogRecord& record, float value) { if (LogArgument* a = nextArgument(record, LogArgument::Real)) a->d = value; }
+    static void add(LogRecord& record, double value) { if (LogArgument* a = nextArgument(record, LogArgument::Real)) a->d = value; }
+
+    static void addSigned(LogRecord& record, long long value) { if (LogArgument* a = nextArgument(record, LogArgument::Int)) a->i = value; }
+    static void addUnsigned(LogRecord& record, unsigned long long value) { if (LogArgument* a = nextArgument(record, LogArgument::UInt)) a->u = value; }
 
     /**
-     * @brief mLogLevel
+     * @brief The level of messages that are written, anything above it is dropped before it is copied.
      */
     static LogLevel mLogLevel;
 };
@@ -0,0 +1,119 @@
+#include "mappedfile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() :
+    mData(0),
+    mSize(0)
+#ifdef _WIN32
+    , mFile(0),
+    mMapping(0)
+#endif
+{ }
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& filePath)
+{
+    close();
+
+    HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    mFile = file;
+    mMapping = mapping;
+    mData = (const char*)data;
+    mSize = (std::size_t)size.QuadPart;
+
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (mData)
+        UnmapViewOfFile(mData);
+
+    if (mMapping)
+        CloseHandle((HANDLE)mMapping);
+
+    if (mFile)
+        CloseHandle((HANDLE)mFile);
+
+    mData = 0;
+    mSize = 0;
+    mFile = 0;
+    mMapping = 0;
+}
+
+#else
+
+bool MappedFile::open(const std::string& filePath)
+{
+    close();
+
+    const int file = ::open(filePath.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size == 0) {
+        ::close(file);
+        return false;
+    }
+
+    void* data = mmap(0, (std::size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+    // The mapping keeps its own reference to the file.
+    ::close(file);
+
+    if (data == MAP_FAILED)
+        return false;
+
+    mData = (const char*)data;
+    mSize = (std::size_t)info.st_size;
+
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (mData)
+        munmap((void*)mData, mSize);
+
+    mData = 0;
+    mSize = 0;
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef MAPPEDFILE_H_INCLUDE
+#define MAPPEDFILE_H_INCLUDE
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief A read only view of a whole file mapped into memory.
+ */
+class MappedFile
+{
+public:
+
+    /**
+     * @brief Create an empty mapping.
+     */
+    MappedFile();
+
+    /**
+     * @brief Unmap the file if it is still open.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Map a file into memory.
+     * @param filePath = The path of the file to map.
+     * @return True if sucessful.
+     */
+    bool open(const std::string& filePath);
+
+    /**
+     * @brief Unmap the file.
+     */
+    void close();
+
+    /**
+     * @brief Check if a file is mapped.
+     * @return True if a file is mapped.
+     */
+    bool isOpen() const { return mData != 0; }
+
+    /**
+     * @brief Get a pointer to the start of the file.
+     * @return A pointer to the file data.
+     */
+    const char* getData() const { return mData; }
+
+    /**
+     * @brief Get the size of the file.
+     * @return The size in bytes.
+     */
+    std::size_t getSize() const { return mSize; }
+
+private:
+
+    /**
+     * @brief The mapped file data.
+     */
+    const char* mData;
+
+    /**
+     * @brief The size of the mapped file.
+     */
+    std::size_t mSize;
+
+#ifdef _WIN32
+    /**
+     * @brief The file and mapping handles.
+     */
+    void* mFile;
+    void* mMapping;
+#endif
+};
+
+#endif // MAPPEDFILE_H_INCLUDE
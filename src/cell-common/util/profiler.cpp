@@ -0,0 +1,242 @@
+#include "profiler.h"
+#include "log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+/**
+ * @brief The rolling samples of a zone.
+ */
+struct ZoneSamples
+{
+    std::string name;
+    std::vector<unsigned long long> samples;
+    unsigned int next;
+    unsigned long long count;
+};
+
+/**
+ * @brief One recorded zone in a trace.
+ */
+struct TraceEvent
+{
+    ProfileZone zone;
+    unsigned int thread;
+    unsigned long long start;
+    unsigned long long duration;
+};
+
+/**
+ * @brief Everything the profiler keeps, made on first use so zones can be added from static initializers.
+ */
+struct ProfilerState
+{
+    std::mutex mutex;
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    std::vector<ZoneSamples> zones;
+
+    std::atomic<bool> tracing{false};
+    std::string tracePath;
+    unsigned long long traceTicks = 0;
+    unsigned long long droppedEvents = 0;
+    std::vector<TraceEvent> traceEvents;
+};
+
+static ProfilerState& getState()
+{
+    static ProfilerState state;
+    return state;
+}
+
+/**
+ * @brief Get a small id for the calling thread, used as the thread id in the trace.
+ * @return The thread id.
+ */
+static unsigned int getThreadId()
+{
+    static std::atomic<unsigned int> nextThreadId{0};
+    thread_local unsigned int threadId = nextThreadId++;
+    return threadId;
+}
+
+ProfileZone Profiler::addZone(const std::string& name)
+{
+    ProfilerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    ZoneSamples zone;
+    zone.name = name;
+    zone.samples.resize(PROFILE_WINDOW, 0);
+    zone.next = 0;
+    zone.count = 0;
+
+    state.zones.push_back(zone);
+
+    return (ProfileZone)(state.zones.size() - 1);
+}
+
+unsigned int Profiler::getZoneCount()
+{
+    ProfilerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    return (unsigned int)state.zones.size();
+}
+
+unsigned long long Profiler::now()
+{
+    const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - getState().epoch;
+    return (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+}
+
+void Profiler::record(ProfileZone zone, unsigned long long start, unsigned long long duration)
+{
+    ProfilerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    ZoneSamples& samples = state.zones[zone];
+    samples.samples[samples.next] = duration;
+    samples.next = (samples.next + 1) % PROFILE_WINDOW;
+    samples.count++;
+
+    if (state.tracing) {
+        if (state.traceEvents.size() < PROFILE_MAX_TRACE_EVENTS) {
+            TraceEvent event = { zone, getThreadId(), start, duration };
+            state.traceEvents.push_back(event);
+        }
+        else {
+            state.droppedEvents++;
+        }
+    }
+}
+
+ZoneStats Profiler::getStats(ProfileZone zone)
+{
+    ProfilerState& state = getState();
+
+    ZoneStats stats;
+    std::vector<unsigned long long> samples;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        const ZoneSamples& zoneSamples = state.zones[zone];
+        const unsigned int sampleCount = (unsigned int)std::min<unsigned long long>(zoneSamples.count, PROFILE_WINDOW);
+
+        stats.name = zoneSamples.name;
+        stats.count = zoneSamples.count;
+        samples.assign(zoneSamples.samples.begin(), zoneSamples.samples.begin() + sampleCount);
+    }
+
+    stats.p50 = 0.0;
+    stats.p99 = 0.0;
+    stats.max = 0.0;
+
+    if (samples.empty())
+        return stats;
+
+    std::sort(samples.begin(), samples.end());
+
+    const std::size_t last = samples.size() - 1;
+    stats.p50 = samples[(last * 50) / 100] / 1e6;
+    stats.p99 = samples[(last * 99) / 100] / 1e6;
+    stats.max = samples[last] / 1e6;
+
+    return stats;
+}
+
+void Profiler::startTrace(const std::string& filePath, unsigned long long tickCount)
+{
+    ProfilerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    if (state.tracing || tickCount == 0)
+        return;
+
+    state.tracePath = filePath;
+    state.traceTicks = tickCount;
+    state.droppedEvents = 0;
+    state.traceEvents.clear();
+    state.tracing = true;
+}
+
+bool Profiler::isTracing()
+{
+    return getState().tracing;
+}
+
+/**
+ * @brief Write recorded trace events to a chrome trace_event file.
+ * @param filePath = The file to write.
+ * @param names = The name of each zone.
+ * @param events = The recorded events.
+ * @param droppedEvents = The number of events that didn't fit, only reported.
+ */
+static void writeTrace(const std::string& filePath, const std::vector<std::string>& names,
+                       const std::vector<TraceEvent>& events, unsigned long long droppedEvents)
+{
+    std::ofstream out(filePath.c_str(), std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        Log::error("failed to write the trace: " + filePath);
+        return;
+    }
+
+    // Complete events with the times in microseconds, chrome://tracing and perfetto both read it.
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    for (std::size_t i = 0; i < events.size(); i++) {
+
+        const TraceEvent& event = events[i];
+
+        if (i > 0)
+            out << ",";
+
+        out << "\n{\"name\":\"" << names[event.zone] << "\",\"ph\":\"X\",\"pid\":1";
+        out << ",\"tid\":" << event.thread;
+        out << ",\"ts\":" << (event.start / 1000) << "." << ((event.start / 100) % 10);
+        out << ",\"dur\":" << (event.duration / 1000) << "." << ((event.duration / 100) % 10) << "}";
+    }
+
+    out << "\n]}\n";
+    out.close();
+
+    std::stringstream sb;
+    sb << "wrote " << events.size() << " trace events to " << filePath;
+    if (droppedEvents > 0)
+        sb << " (dropped " << droppedEvents << ")";
+    Log::info(sb.str());
+}
+
+void Profiler::endTick()
+{
+    ProfilerState& state = getState();
+
+    if (!state.tracing)
+        return;
+
+    std::string filePath;
+    std::vector<std::string> names;
+    std::vector<TraceEvent> events;
+    unsigned long long droppedEvents = 0;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        if (!state.tracing || --state.traceTicks > 0)
+            return;
+
+        // Take the events out so a new trace can start while this one is written.
+        state.tracing = false;
+        filePath = state.tracePath;
+        droppedEvents = state.droppedEvents;
+        events.swap(state.traceEvents);
+
+        for (const ZoneSamples& zone : state.zones)
+            names.push_back(zone.name);
+    }
+
+    writeTrace(filePath, names, events, droppedEvents);
+}
@@ -0,0 +1,132 @@
+#ifndef PROFILER_H_INCLUDE
+#define PROFILER_H_INCLUDE
+
+#include <string>
+
+typedef unsigned int ProfileZone;
+
+/**
+ * @brief The number of recent samples each zone keeps for its percentiles.
+ */
+static const unsigned int PROFILE_WINDOW = 256;
+
+/**
+ * @brief The most events kept while recording a trace, any more are dropped.
+ */
+static const unsigned int PROFILE_MAX_TRACE_EVENTS = 1 << 20;
+
+/**
+ * @brief The recent timings of a zone, in milliseconds.
+ */
+struct ZoneStats
+{
+    std::string name;
+    unsigned long long count;
+    double p50;
+    double p99;
+    double max;
+};
+
+/**
+ * @brief Times named zones of code, keeping a rolling window of samples for each one and
+ * optionally recording every zone for a number of ticks into a chrome trace_event file.
+ * The zones can be recorded from any thread.
+ */
+class Profiler
+{
+public:
+
+    /**
+     * @brief Add a new zone, usually once into a static in the file that times it.
+     * @param name = The name of the zone shown in the overlay and the trace.
+     * @return The zone id.
+     */
+    static ProfileZone addZone(const std::string& name);
+
+    /**
+     * @brief Get the number of zones added so far.
+     * @return The zone count.
+     */
+    static unsigned int getZoneCount();
+
+    /**
+     * @brief Get the current time of the profiler clock.
+     * @return The nanoseconds since the profiler started.
+     */
+    static unsigned long long now();
+
+    /**
+     * @brief Record one timing of a zone.
+     * @param zone = The zone that was timed.
+     * @param start = The profiler time the zone started at.
+     * @param duration = The time spent in the zone, in nanoseconds.
+     */
+    static void record(ProfileZone zone, unsigned long long start, unsigned long long duration);
+
+    /**
+     * @brief Get the timings of a zone over its recent samples.
+     * @param zone = The zone to get the stats of.
+     * @return The zone stats.
+     */
+    static ZoneStats getStats(ProfileZone zone);
+
+    /**
+     * @brief Start recording every zone into a chrome trace_event file.
+     * @param filePath = The file to write the trace to once it is done.
+     * @param tickCount = The number of ticks to record.
+     */
+    static void startTrace(const std::string& filePath, unsigned long long tickCount);
+
+    /**
+     * @brief Check if a trace is being recorded.
+     * @return True if a trace is being recorded.
+     */
+    static bool isTracing();
+
+    /**
+     * @brief Mark the end of a tick, the trace is written once it has recorded enough of them.
+     */
+    static void endTick();
+};
+
+/**
+ * @brief Times the zone for as long as it is in scope.
+ */
+class ProfileScope
+{
+public:
+
+    /**
+     * @brief Start timing a zone.
+     * @param zone = The zone to time.
+     */
+    explicit ProfileScope(ProfileZone zone) :
+        mZone(zone),
+        mStart(Profiler::now())
+    { }
+
+    /**
+     * @brief Stop timing the zone and record it.
+     */
+    ~ProfileScope()
+    {
+        Profiler::record(mZone, mStart, Profiler::now() - mStart);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+
+    /**
+     * @brief The zone being timed.
+     */
+    ProfileZone mZone;
+
+    /**
+     * @brief The profiler time the zone started at.
+     */
+    unsigned long long mStart;
+};
+
+#endif // PROFILER_H_INCLUDE
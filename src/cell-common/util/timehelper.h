@@ -1,7 +0,0 @@
-#pragma once
-
-#include <string>
-
-// Get current date/time, format is YYYY-MM-DD.HH:mm:ss.
-const std::string currentDateTime();
-
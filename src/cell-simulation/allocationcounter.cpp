@@ -0,0 +1,72 @@
+#include "allocationcounter.h"
+
+// Standard includes.
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<u64> allocationCount(0);
+static std::atomic<u64> allocationBytes(0);
+
+static void* countedAllocate(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+
+    return std::malloc(size ? size : 1);
+}
+
+u64 AllocationCounter::getCount()
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+u64 AllocationCounter::getBytes()
+{
+    return allocationBytes.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size)
+{
+    void* memory = countedAllocate(size);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+
+    return memory;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAllocate(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
@@ -0,0 +1,28 @@
+#ifndef ALLOCATIONCOUNTER_H_INCLUDE
+#define ALLOCATIONCOUNTER_H_INCLUDE
+
+#include <scl/types.h>
+
+/**
+ * @brief Counts the heap allocations made through the global operator new.
+ * Linking allocationcounter.cpp into an executable replaces operator new and delete for the whole program,
+ * it is only meant for the tools that measure the simulation, never for the core library.
+ */
+class AllocationCounter
+{
+public:
+
+    /**
+     * @brief Get the number of allocations made since the program started.
+     * @return The allocation count.
+     */
+    static u64 getCount();
+
+    /**
+     * @brief Get the number of bytes allocated since the program started.
+     * @return The allocated byte count.
+     */
+    static u64 getBytes();
+};
+
+#endif // ALLOCATIONCOUNTER_H_INCLUDE
@@ -0,0 +1,287 @@
+// Times the hot paths of the simulation without a window or a gl context.
+// Usage: cell-bench [filter] [threads]
+// Only the benchmarks with the filter in their name are run, an empty filter runs all of them.
+// Everything is generated from fixed seeds and nothing is loaded or saved, so the same build
+// always times the same work and the numbers can be compared between changes.
+
+#include "simulation/world.h"
+#include "simulation/cell.h"
+#include "simulation/genetics/breeder.h"
+#include "simulation/partitioning/spatialgrid.h"
+#include "allocationcounter.h"
+#include "mathutils.h"
+
+#include <util/log.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock BenchClock;
+
+// The seed every benchmark generates its data from.
+const u64 BENCH_SEED = 42;
+
+// A micro benchmark doubles its iteration count until one run takes at least this long.
+const r64 MIN_RUN_TIME = 0.1;
+
+// The number of timed runs of a micro benchmark, the fastest and the median are reported.
+const u32 RUN_COUNT = 5;
+
+// The number of locations used by the spatial grid benchmarks.
+const u32 GRID_ENTITY_COUNT = 10000;
+
+// The number of lines and circles the intersection benchmark cycles through.
+const u32 INTERSECT_COUNT = 1024;
+
+// The number of networks evaluated per batch.
+const u32 NETWORK_BATCH_SIZE = 256;
+
+// The number of entities in a new world, the world benchmarks keep the same mix.
+const u32 START_ENTITY_COUNT = START_CELL_COUNT + START_FIRE_COUNT + START_FOOD_COUNT;
+
+// Written to by every benchmark so the compiler can't throw the timed work away.
+static volatile r32 sink = 0.0f;
+
+/**
+ * @brief Check if a benchmark should run.
+ * @param name = The name of the benchmark.
+ * @param filter = The filter given on the command line.
+ * @return True if the filter is empty or the name contains it.
+ */
+static bool isSelected(const std::string& name, const std::string& filter)
+{
+    return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+/**
+ * @brief Time a function that runs the benchmark body a given number of times.
+ * @param name = The name of the benchmark.
+ * @param itemsPerIteration = The number of items each iteration works on, the time is reported per item.
+ * @param run = The function to time, called with the number of iterations to run.
+ */
+template <typename Function>
+static void runBenchmark(const std::string& name, u64 itemsPerIteration, Function run)
+{
+    // Find an iteration count that runs for long enough to time.
+    u64 iterations = 1;
+    for (;;) {
+        const BenchClock::time_point start = BenchClock::now();
+        run(iterations);
+        const r64 elapsed = std::chrono::duration<r64>(BenchClock::now() - start).count();
+
+        if (elapsed >= MIN_RUN_TIME)
+            break;
+
+        iterations *= 2;
+    }
+
+    std::vector<r64> times;
+    times.reserve(RUN_COUNT);
+
+    const u64 allocations = AllocationCounter::getCount();
+
+    for (u32 i = 0; i < RUN_COUNT; i++) {
+        const BenchClock::time_point start = BenchClock::now();
+        run(iterations);
+        times.push_back(std::chrono::duration<r64>(BenchClock::now() - start).count());
+    }
+
+    const r64 items = (r64)iterations * itemsPerIteration;
+    const r64 runAllocations = (r64)(AllocationCounter::getCount() - allocations) / RUN_COUNT;
+
+    std::sort(times.begin(), times.end());
+
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1);
+    std::cout << std::setw(12) << (times.front() * 1e9 / items) << " ns/op (min)";
+    std::cout << std::setw(12) << (times[RUN_COUNT / 2] * 1e9 / items) << " ns/op (median)";
+    std::cout << std::setprecision(3);
+    std::cout << std::setw(10) << (runAllocations / items) << " allocs/op" << std::endl;
+}
+
+/**
+ * @brief Time the world update with a given number of entities.
+ * @param entityCount = The number of entities the world starts with.
+ * @param ticks = The number of timed updates.
+ * @param threads = The number of threads to update with, (0 for one per core)
+ */
+static void runWorldBenchmark(u32 entityCount, u32 ticks, u32 threads)
+{
+    const r32 dt = 1.0f / 60.0f;
+
+    // Grow the world with the entity count so the density, and with it the
+    // neighbour and collision work per entity, stays the same as a new world.
+    const r32 scale = std::sqrt((r32)entityCount / START_ENTITY_COUNT);
+    const u32 groups = entityCount / START_ENTITY_COUNT;
+    const u32 remainder = entityCount % START_ENTITY_COUNT;
+
+    World world(DEFAULT_WORLD_RADIUS * scale);
+    world.setThreadCount(threads);
+    world.setSeed(BENCH_SEED);
+    world.populate(groups * START_CELL_COUNT, groups * START_FIRE_COUNT, groups * START_FOOD_COUNT + remainder);
+
+    // Let the first births and deaths settle before timing.
+    for (u32 i = 0; i < 10; i++)
+        world.update(dt);
+
+    const u64 allocations = AllocationCounter::getCount();
+    u64 entityTicks = 0;
+
+    const BenchClock::time_point start = BenchClock::now();
+
+    for (u32 i = 0; i < ticks; i++) {
+        entityTicks += world.getEntityCount();
+        world.update(dt);
+    }
+
+    const r64 elapsed = std::chrono::duration<r64>(BenchClock::now() - start).count();
+    const r64 tickAllocations = (r64)(AllocationCounter::getCount() - allocations) / ticks;
+
+    std::cout << "world/update/" << std::left << std::setw(15) << entityCount << std::right << std::fixed;
+    std::cout << std::setprecision(1) << std::setw(12) << (ticks / elapsed) << " ticks/sec";
+    std::cout << std::setw(12) << (elapsed * 1e9 / entityTicks) << " ns/entity";
+    std::cout << std::setw(12) << (tickAllocations) << " allocs/tick";
+    std::cout << ", " << world.getThreadCount() << " threads, " << world.getEntityCount() << " entities at the end";
+    std::cout << std::endl;
+}
+
+int main(int argc, char* args[])
+{
+    const std::string filter = (argc > 1) ? args[1] : "";
+    const u32 threads = (argc > 2) ? (u32)std::strtoul(args[2], 0, 10) : 0;
+
+    // Every new cell writes to the log, keep it out of the timings.
+    Log::setLogLevel(LOG_LEVEL_ERROR);
+
+    {
+        // The world sets up the network every genome is sized for.
+        World world;
+        const NeuralNetwork& network = *World::m_neuralNetwork;
+
+        std::cout << "network kernel: " << getKernelName(network.getKernel()) << std::endl;
+
+        RandomGen random(BENCH_SEED, 0, 0, RandomPurpose::Populate);
+
+        std::vector<DNA> parents;
+        std::vector<const r32*> weights;
+        for (u32 i = 0; i < NETWORK_BATCH_SIZE; i++)
+            parents.push_back(DNA(random));
+        for (u32 i = 0; i < NETWORK_BATCH_SIZE; i++)
+            weights.push_back(parents[i].genome.readWeights());
+
+        std::vector<r32> inputs(NETWORK_BATCH_SIZE * network.getInputCount());
+        std::vector<r32> outputs(NETWORK_BATCH_SIZE * network.getOutputCount());
+        for (r32& input : inputs)
+            input = random.randomFloat(-1.0f, 1.0f);
+
+        if (isSelected("network/computeOutputs", filter)) {
+            runBenchmark("network/computeOutputs", 1, [&](u64 iterations) {
+                for (u64 i = 0; i < iterations; i++) {
+                    const u32 n = (u32)(i % NETWORK_BATCH_SIZE);
+                    network.computeOutputs(weights[n], &inputs[n * network.getInputCount()], &outputs[0]);
+                    sink = outputs[0];
+                }
+            });
+        }
+
+        if (isSelected("network/computeBatch", filter)) {
+            runBenchmark("network/computeBatch", NETWORK_BATCH_SIZE, [&](u64 iterations) {
+                for (u64 i = 0; i < iterations; i++) {
+                    network.computeBatch(&weights[0], &inputs[0], &outputs[0], NETWORK_BATCH_SIZE);
+                    sink = outputs[0];
+                }
+            });
+        }
+
+        if (isSelected("math/circleLineIntersect", filter)) {
+
+            std::vector<vec2f> points(INTERSECT_COUNT * 3);
+            std::vector<r32> radii(INTERSECT_COUNT);
+            for (vec2f& point : points)
+                point = vec2f(random.randomFloat(-100.0f, 100.0f), random.randomFloat(-100.0f, 100.0f));
+            for (r32& radius : radii)
+                radius = random.randomFloat(1.0f, CELL_MAX_RADIUS);
+
+            runBenchmark("math/circleLineIntersect", INTERSECT_COUNT, [&](u64 iterations) {
+                for (u64 i = 0; i < iterations; i++) {
+                    r32 total = 0.0f;
+                    for (u32 j = 0; j < INTERSECT_COUNT; j++) {
+                        r32 dist = 0.0f;
+                        if (circleLineIntersect(points[j * 3], points[j * 3 + 1], points[j * 3 + 2], radii[j], &dist))
+                            total += dist;
+                    }
+                    sink = total;
+                }
+            });
+        }
+
+        const bool gridRebuild = isSelected("grid/rebuild", filter);
+        const bool gridQuery = isSelected("grid/query", filter);
+        const bool gridForEachNear = isSelected("grid/forEachNear", filter);
+
+        if (gridRebuild || gridQuery || gridForEachNear) {
+
+            SpatialGrid grid(world.getRadius());
+
+            std::vector<vec2f> locations(GRID_ENTITY_COUNT);
+            for (vec2f& location : locations)
+                location = world.randomWorldPoint(random);
+
+            if (gridRebuild) {
+                runBenchmark("grid/rebuild", GRID_ENTITY_COUNT, [&](u64 iterations) {
+                    for (u64 i = 0; i < iterations; i++)
+                        grid.rebuild(locations);
+                });
+            }
+
+            grid.rebuild(locations);
+
+            if (gridQuery) {
+                std::vector<u32> list;
+                runBenchmark("grid/query", 1, [&](u64 iterations) {
+                    for (u64 i = 0; i < iterations; i++) {
+                        list.clear();
+                        grid.query((u32)(i % GRID_ENTITY_COUNT), 1, list);
+                        sink = (r32)list.size();
+                    }
+                });
+            }
+
+            if (gridForEachNear) {
+                runBenchmark("grid/forEachNear", 1, [&](u64 iterations) {
+                    for (u64 i = 0; i < iterations; i++) {
+                        u32 count = 0;
+                        grid.forEachNear((u32)(i % GRID_ENTITY_COUNT), 2, [&](u32) { count++; });
+                        sink = (r32)count;
+                    }
+                });
+            }
+        }
+
+        if (isSelected("genetics/replicate", filter)) {
+            runBenchmark("genetics/replicate", 1, [&](u64 iterations) {
+                for (u64 i = 0; i < iterations; i++) {
+                    RandomGen mutations(BENCH_SEED, i, 0, RandomPurpose::Split);
+                    const DNA child = Breeder::replicate(parents[i % NETWORK_BATCH_SIZE], mutations);
+                    sink = child.genome.readWeights()[0];
+                }
+            });
+        }
+    }
+
+    if (isSelected("world/update/1000", filter))
+        runWorldBenchmark(1000, 1000, threads);
+
+    if (isSelected("world/update/10000", filter))
+        runWorldBenchmark(10000, 200, threads);
+
+    if (isSelected("world/update/100000", filter))
+        runWorldBenchmark(100000, 20, threads);
+
+    return 0;
+}
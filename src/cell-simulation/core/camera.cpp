@@ -6,8 +6,7 @@ Camera::Camera() :
     m_mode(mode::Free),
     m_speed(250.0f),
     m_zoomSpeed(0.01f),
-    m_location(0, 0),
-    m_trackingEntity(0)
+    m_location(0, 0)
 { }
 
 void Camera::resize(const u32 width, const u32 height)
@@ -15,13 +14,13 @@ void Camera::resize(const u32 width, const u32 height)
     m_view.setSize(width, height);
 }
 
-void Camera::trackEntity(Entity* entity)
+void Camera::trackEntity(EntityHandle entity)
 {
     m_mode = mode::Track;
     m_trackingEntity = entity;
 }
 
-void Camera::update(const r32 dt)
+void Camera::update(const World& world, const r32 dt, const r32 alpha)
 {
     // If we are in the tracking mode,
     // Update our position to be the same as the entities position as long as it is valid.
@@ -29,8 +28,11 @@ void Camera::update(const r32 dt)
 
         // Make sure we have a valid entity to track
         // Otherwise we want to pop back out of the track mode.
-        if (m_trackingEntity) {
-            m_location = m_trackingEntity->getLocation();
+        const EntityStore& store = world.getStore();
+        const u32 index = store.getIndex(m_trackingEntity);
+
+        if (index != INVALID_INDEX) {
+            m_location = store.getInterpolatedLocation(index, alpha);
             m_view.setCenter(m_location.x, m_location.y);
         }
         else {
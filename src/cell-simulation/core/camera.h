@@ -10,7 +10,7 @@
 #include <scl/math/vec3.h>
 
 // Project includes.
-#include "../simulation/entity.h"
+#include "../simulation/world.h"
 
 namespace mode
 {
@@ -47,9 +47,11 @@ public:
 
     /**
      * @brief Occurs when the camera is updated.
+     * @param world = The world the tracked entity exists in.
      * @param dt = Delta time.
+     * @param alpha = The blend factor between the previous and the current simulation step.
      */
-    void update(const r32 dt);
+    void update(const World& world, const r32 dt, const r32 alpha);
 
     /**
      * @brief Occurs when the camera is rendered.
@@ -59,9 +61,9 @@ public:
 
     /**
      * @brief Track an entity until it dies or the camera mode was switched.
-     * @param entity = The entity to track.
+     * @param entity = The handle of the entity to track.
      */
-    void trackEntity(Entity* entity);
+    void trackEntity(EntityHandle entity);
 
     /**
      * @brief Get the view for the camera.
@@ -123,7 +125,7 @@ private:
     /**
      * @brief The entity that the camera is currently tracking if any.
      */
-    Entity* m_trackingEntity;
+    EntityHandle m_trackingEntity;
 };
 
 #endif // CAMERA_H_INCLUDE
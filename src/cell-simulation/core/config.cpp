@@ -1,4 +1,5 @@
 #include "config.h"
+#include "../simulation/randomgen.h"
 
 int Config::m_width = 1024;
 int Config::m_height = 768;
@@ -6,6 +7,16 @@ int Config::m_fps = 60;
 int Config::m_aaLevel = 0;
 bool Config::m_vsync = false;
 bool Config::m_fullscreen = false;
+float Config::m_tickRate = 60.0f;
+int Config::m_maxSteps = 5;
+int Config::m_turbo = 0;
+int Config::m_seed = (int)DEFAULT_SEED;
+int Config::m_checkpointInterval = 36000;
+int Config::m_checkpointRetention = 3;
+int Config::m_traceTicks = 600;
+int Config::m_recordEvents = 0;
+bool Config::m_resume = true;
+std::string Config::m_kernel = "auto";
 
 void Config::load(std::string configFile)
 {
@@ -30,6 +41,37 @@ void Config::load(std::string configFile)
     m_fullscreen = config.get("fullscreen").get<bool>();
     m_vsync = config.get("vsync").get<bool>();
 
+    // The simulation settings were added later, older config files won't have them.
+    if (config.contains("tick_rate"))
+        m_tickRate = (float) config.get("tick_rate").get<double>();
+
+    if (config.contains("max_steps"))
+        m_maxSteps = (int) config.get("max_steps").get<double>();
+
+    if (config.contains("turbo"))
+        m_turbo = (int) config.get("turbo").get<double>();
+
+    if (config.contains("seed"))
+        m_seed = (int) config.get("seed").get<double>();
+
+    if (config.contains("checkpoint_interval"))
+        m_checkpointInterval = (int) config.get("checkpoint_interval").get<double>();
+
+    if (config.contains("checkpoint_retention"))
+        m_checkpointRetention = (int) config.get("checkpoint_retention").get<double>();
+
+    if (config.contains("trace_ticks"))
+        m_traceTicks = (int) config.get("trace_ticks").get<double>();
+
+    if (config.contains("record_events"))
+        m_recordEvents = (int) config.get("record_events").get<double>();
+
+    if (config.contains("resume"))
+        m_resume = config.get("resume").get<bool>();
+
+    if (config.contains("kernel"))
+        m_kernel = config.get("kernel").get<std::string>();
+
     input.close();
 }
 
@@ -49,6 +91,16 @@ void Config::save(std::string configFile)
     config["vsync"] = picojson::value(m_vsync);
     config["fullscreen"] = picojson::value(m_fullscreen);
     config["antialiasing"] = picojson::value((double)m_aaLevel);
+    config["tick_rate"] = picojson::value((double) m_tickRate);
+    config["max_steps"] = picojson::value((double) m_maxSteps);
+    config["turbo"] = picojson::value((double) m_turbo);
+    config["seed"] = picojson::value((double) m_seed);
+    config["checkpoint_interval"] = picojson::value((double) m_checkpointInterval);
+    config["checkpoint_retention"] = picojson::value((double) m_checkpointRetention);
+    config["trace_ticks"] = picojson::value((double) m_traceTicks);
+    config["record_events"] = picojson::value((double) m_recordEvents);
+    config["resume"] = picojson::value(m_resume);
+    config["kernel"] = picojson::value(m_kernel);
     //pass true to serialize in a neat readable format.
     output << picojson::value(config).serialize(true) << std::endl;
 
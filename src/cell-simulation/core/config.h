@@ -31,12 +31,32 @@ public:
     static int getFpsLimit() { return m_fps; }
     static bool getFullscreen() { return m_fullscreen; }
     static bool getVSync() { return m_vsync; }
+    static float getTickRate() { return m_tickRate; }
+    static int getMaxSteps() { return m_maxSteps; }
+    static int getTurbo() { return m_turbo; }
+    static int getSeed() { return m_seed; }
+    static int getCheckpointInterval() { return m_checkpointInterval; }
+    static int getCheckpointRetention() { return m_checkpointRetention; }
+    static int getTraceTicks() { return m_traceTicks; }
+    static int getRecordEvents() { return m_recordEvents; }
+    static bool getResume() { return m_resume; }
+    static const std::string& getKernel() { return m_kernel; }
 
     static void setWidth(int width) { m_width = width; }
     static void setHeight(int height) { m_height = height; }
     static void setFPSLimit(int fps) { m_fps = fps; }
     static void setFullscreen(bool fullscreen) { m_fullscreen = fullscreen; }
     static void setVSync(bool vsync) { m_vsync = vsync; }
+    static void setTickRate(float tickRate) { m_tickRate = tickRate; }
+    static void setMaxSteps(int maxSteps) { m_maxSteps = maxSteps; }
+    static void setTurbo(int turbo) { m_turbo = turbo; }
+    static void setSeed(int seed) { m_seed = seed; }
+    static void setCheckpointInterval(int interval) { m_checkpointInterval = interval; }
+    static void setCheckpointRetention(int retention) { m_checkpointRetention = retention; }
+    static void setTraceTicks(int traceTicks) { m_traceTicks = traceTicks; }
+    static void setRecordEvents(int recordEvents) { m_recordEvents = recordEvents; }
+    static void setResume(bool resume) { m_resume = resume; }
+    static void setKernel(const std::string& kernel) { m_kernel = kernel; }
 
 private:
 
@@ -70,6 +90,56 @@ private:
      */
     static bool m_vsync;
 
+    /**
+     * @brief The number of fixed simulation steps per second.
+     */
+    static float m_tickRate;
+
+    /**
+     * @brief The max number of simulation steps run in one frame when catching up.
+     */
+    static int m_maxSteps;
+
+    /**
+     * @brief The number of simulation steps per rendered frame in turbo mode, (0 for off)
+     */
+    static int m_turbo;
+
+    /**
+     * @brief The seed of the simulation, the same seed and saved state give the same run.
+     */
+    static int m_seed;
+
+    /**
+     * @brief The number of simulation steps between background checkpoints, (0 for off)
+     */
+    static int m_checkpointInterval;
+
+    /**
+     * @brief The number of checkpoint files to keep.
+     */
+    static int m_checkpointRetention;
+
+    /**
+     * @brief The number of simulation steps recorded into a profiler trace.
+     */
+    static int m_traceTicks;
+
+    /**
+     * @brief Which events are recorded to the event file, (0 for none, 1 for births, deaths and consumption, 2 adds collisions)
+     */
+    static int m_recordEvents;
+
+    /**
+     * @brief The flag to carry on the last run from its snapshot, otherwise a fresh run is started with the seed.
+     */
+    static bool m_resume;
+
+    /**
+     * @brief The network kernel, (auto for the fastest the cpu supports, scalar for the same results on every cpu)
+     */
+    static std::string m_kernel;
+
 }; //class Config
 
 #endif // CONFIG_H_INCLUDE
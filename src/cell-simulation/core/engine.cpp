@@ -1,6 +1,7 @@
 #include "engine.h"
 
 // Standard includes.
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <iomanip>
@@ -13,20 +14,18 @@
 // Project includes.
 #include "content.h"
 #include "console.h"
+#include "config.h"
 
-Engine::Engine() :
-
-    m_avgRenderTime(0.0f),
-    m_avgRenderAcc(0.0f),
-    m_avgRenderCounter(1.0f),
+static const ProfileZone UPDATE_ZONE = Profiler::addZone("update");
+static const ProfileZone RENDER_ZONE = Profiler::addZone("render");
 
-    m_avgUpdateTime(0.0f),
-    m_avgUpdateAcc(0.0f),
-    m_avgUpdateCounter(1.0f),
+Engine::Engine() :
 
     m_fps(0),
     m_fpsTicks(0),
     m_maxDeltaTime(0.0f),
+    m_debugText(0),
+    m_profileText(0),
 
     m_entityTrackingIndex(0)
 { }
@@ -36,10 +35,6 @@ Engine::~Engine()
 
 bool Engine::initialize()
 {
-    time_t t;
-    time(&t);
-    srand(t);
-
     // Initialize and load the content before we create the rest of the objects
     // Since they may need to use them.
     if(!Content::initialize()) {
@@ -52,13 +47,39 @@ bool Engine::initialize()
     m_debugText->setStyle(sf::Text::Bold);
     m_debugText->setFont(*Content::font);
 
+    m_profileText = new sf::Text();
+    m_profileText->setCharacterSize(16);
+    m_profileText->setFont(*Content::font);
+    m_profileText->setPosition(Config::getWidth() - PROFILE_TEXT_WIDTH, 1.0f);
+
     m_shader = Content::shader;
 
-    if (!m_world.initialize()) {
+    m_scheduler.setTickRate(Config::getTickRate());
+    m_scheduler.setMaxSteps(Config::getMaxSteps() > 0 ? Config::getMaxSteps() : 1);
+    m_scheduler.setTurbo(Config::getTurbo() > 0 ? Config::getTurbo() : 0);
+
+    m_world.setSeed((u64)Config::getSeed());
+
+    // Carrying on with another kernel would quietly give a different run.
+    if (!m_world.setKernel(Config::getKernel())) {
+        return false;
+    }
+
+    m_world.setCheckpoints(Config::getCheckpointInterval() > 0 ? Config::getCheckpointInterval() : 0,
+                           Config::getCheckpointRetention());
+
+    if (Config::getRecordEvents() > 0)
+        m_world.getEvents().open(EVENT_FILE_PATH, Config::getRecordEvents() > 1);
+
+    if (!m_world.initialize(Config::getResume())) {
         return false;
     }
 
-    m_camera.trackEntity(m_world.getEntities()[0]);
+    if (!m_worldRenderer.initialize(m_world)) {
+        return false;
+    }
+
+    m_camera.trackEntity(m_world.getStore().getHandle(0));
 
     return true;//m_ircBot.initialize();
 }
@@ -70,7 +91,11 @@ void Engine::destroy()
     if (m_debugText)
        delete m_debugText;
 
+    if (m_profileText)
+       delete m_profileText;
+
     Console::destroy();
+    m_worldRenderer.destroy();
     m_world.destroy();
     Content::destroy();
 }
@@ -78,6 +103,10 @@ void Engine::destroy()
 void Engine::resize(const u32 width, const u32 height)
 {
     m_textView = sf::View(sf::FloatRect(sf::Vector2f(), sf::Vector2f(width, height)));
+
+    // Keep the profiler timings in the top right corner, out of the way of the other debug text.
+    if (m_profileText)
+        m_profileText->setPosition(width - PROFILE_TEXT_WIDTH, 1.0f);
     m_camera.resize(width, height);
 }
 
@@ -102,46 +131,59 @@ void Engine::keyPress(sf::Event::KeyEvent e)
     }
     else if (e.code == sf::Keyboard::I) {
         // Swap the debug flag.
-        m_world.setDebug(!m_world.getDebug());
+        m_worldRenderer.setDebug(!m_worldRenderer.getDebug());
+    }
+    else if (e.code == sf::Keyboard::P) {
+        // Record the next few seconds of ticks and frames into a trace file.
+        if (!Profiler::isTracing() && Config::getTraceTicks() > 0) {
+            Profiler::startTrace(TRACE_FILE_PATH, (u64)Config::getTraceTicks());
+            Log::info("recording a trace of the next " + std::to_string(Config::getTraceTicks()) + " ticks");
+        }
+    }
+    else if (e.code == sf::Keyboard::L) {
+        // Write out the family tree of the living cells.
+        m_world.getLineage().writeNewick(LINEAGE_FILE_PATH);
+    }
+    else if (e.code == sf::Keyboard::Add) {
+        // Double the turbo steps, starting at two steps per frame.
+        const u32 turbo = m_scheduler.getTurbo();
+        m_scheduler.setTurbo(turbo == 0 ? 2 : std::min(turbo * 2, MAX_TURBO));
+    }
+    else if (e.code == sf::Keyboard::Subtract) {
+        // Halve the turbo steps, dropping back to real time below two.
+        const u32 turbo = m_scheduler.getTurbo() / 2;
+        m_scheduler.setTurbo(turbo < 2 ? 0 : turbo);
     }
 
     if (nowTracking) {
 
-        Entity* entity = m_world.getEntity(m_entityTrackingIndex);
+        const EntityStore& store = m_world.getStore();
 
         u32 counter = 0;
-        while(entity->getType() != EntityType::Cell && counter < m_world.getEntityCount()) {
+        while(store.type[m_entityTrackingIndex] != EntityType::Cell && counter < m_world.getEntityCount()) {
            m_entityTrackingIndex = (m_entityTrackingIndex + 1) % m_world.getEntityCount();
-           entity = m_world.getEntity(m_entityTrackingIndex);
            counter++;
         }
 
-        if (entity)
-            m_camera.trackEntity(entity);
+        m_camera.trackEntity(store.getHandle(m_entityTrackingIndex));
     }
 }
 
 void Engine::update(const r32 dt)
 {
-    // Begin the measuring the time for this update cycle.
-    m_updateTimer.restart();
+    ProfileScope zone(UPDATE_ZONE);
 
     m_camera.applyKeyboardControls(dt);
 
-    m_world.update(dt);
-
-    m_camera.update(dt);
+    // Run the simulation in fixed steps so the result doesn't depend on the frame rate.
+    const u32 steps = m_scheduler.advance(dt);
+    const r32 stepTime = m_scheduler.getStepTime();
 
-    // Update the average update time.
-    m_avgUpdateAcc += m_updateTimer.getElapsedTime().asSeconds();
-    m_avgUpdateCounter++;
-    m_avgUpdateTime = m_avgUpdateAcc / m_avgUpdateCounter;
+    for (u32 i = 0; i < steps; i++) {
+        m_world.update(stepTime);
+    }
 
-    // Reset the average update counter after so many.
-    /*if (m_avgUpdateCounter > 2500) {
-        m_avgUpdateCounter = 1.0f;
-        m_avgUpdateAcc = 0.0f;
-    }*/
+    m_camera.update(m_world, dt, m_scheduler.getAlpha());
 
     Console::update();
 
@@ -157,50 +199,74 @@ void Engine::updateDebugInfo()
         m_debugTextTimer.restart();
 
         std::stringstream str;
-        str << std::fixed << std::setprecision(8);
-
-        str << "avg rtime: " << m_avgRenderTime << std::endl;
-        str << "avg utime: " << m_avgUpdateTime << std::endl;
-        str << std::setprecision(2);
+        str << std::fixed << std::setprecision(2);
         str << "fps: " << m_fps << std::endl;
         str << "max dt: " << m_maxDeltaTime << std::endl;
+        str << "tick: " << m_scheduler.getTick() << " (" << m_scheduler.getTickRate() << "/s";
+        if (m_scheduler.getTurbo() > 0)
+            str << ", turbo x" << m_scheduler.getTurbo();
+        str << ", dropped: " << m_scheduler.getDroppedSteps() << ")" << std::endl;
         //str << "scale: " << m_worldScale << std::endl;
 
+        const EntityStoreStats pools = m_world.getStore().getStats();
+        str << "cells: " << pools.cells.count << " (peak " << pools.cells.highWater << ")";
+        str << ", food: " << pools.food.count << " (peak " << pools.food.highWater << ")";
+        str << ", fire: " << pools.fire.count << " (peak " << pools.fire.highWater << ")" << std::endl;
+
         vec2f cameraLocation = m_camera.getLocation();
         str << "cam offset: (x: " << cameraLocation.x << ", y: " << cameraLocation.y << ")" << std::endl;
+
         m_debugText->setString(str.str());
+
+        // The frame timings are always shown, every other zone only in debug mode.
+        std::stringstream profile;
+        profile << std::fixed;
+        profile << "ms (p50 / p99 / max)";
+        if (Profiler::isTracing())
+            profile << ", tracing";
+        profile << std::endl;
+
+        writeZoneStats(profile, UPDATE_ZONE);
+        writeZoneStats(profile, RENDER_ZONE);
+
+        if (m_worldRenderer.getDebug()) {
+            for (ProfileZone zone = 0; zone < Profiler::getZoneCount(); zone++) {
+                if (zone != UPDATE_ZONE && zone != RENDER_ZONE)
+                    writeZoneStats(profile, zone);
+            }
+        }
+
+        m_profileText->setString(profile.str());
     }
 }
 
+void Engine::writeZoneStats(std::stringstream& str, ProfileZone zone)
+{
+    const ZoneStats stats = Profiler::getStats(zone);
+
+    str << std::setprecision(3);
+    str << std::left << std::setw(14) << stats.name << std::right;
+    str << stats.p50 << " / " << stats.p99 << " / " << stats.max << std::endl;
+}
+
 void Engine::render(sf::RenderTarget& target)
 {
-    // Being the measuring the time for this render cycle.
-    m_renderTimer.restart();
+    ProfileScope zone(RENDER_ZONE);
 
     // Make sure we have updated d
     updateDebugInfo();
 
     // Draw stuff here in the world view.
-    m_world.render(target, m_camera, m_textView);
+    m_worldRenderer.render(target, m_world, m_camera, m_textView, m_scheduler.getAlpha());
 
     // Update the view so we see text properly.
     target.setView(m_textView);
 
     target.draw(*m_debugText);
+    target.draw(*m_profileText);
 
     Console::render(target);
 
-    // Reset the average render counter after so many.
-    /*if (m_avgRenderCounter > 2500) {
-        m_avgRenderCounter = 1.0f;
-        m_avgRenderAcc = 0.0f;
-    }*/
-
-    // Average the render time measured with the render time.
-    m_avgRenderAcc += m_renderTimer.getElapsedTime().asSeconds();
-    m_avgRenderCounter++;
-    m_avgRenderTime = m_avgRenderAcc / m_avgRenderCounter;
-
     // Update the frame counter too. we don't really need it but why not.
     m_fpsTicks++;
     if (m_fpsTimer.getElapsedTime().asSeconds() >= 1.0f) {
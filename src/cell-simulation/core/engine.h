@@ -14,15 +14,27 @@
 
 // Standard includes.
 #include <string>
+#include <sstream>
+
+// Common library includes.
+#include <util/profiler.h>
 
 // Project includes.
 #include "../simulation/world.h"
+#include "../simulation/scheduler.h"
+#include "../render/worldrenderer.h"
 #include "camera.h"
 
 //#include "../irc/ircbot.h"
 
 const r32 ZOOM_MIN = 0.0001f;
 
+// The most simulation steps run per frame in turbo mode.
+const u32 MAX_TURBO = 1024;
+
+// The space kept for the profiler timings on the right of the window.
+const r32 PROFILE_TEXT_WIDTH = 320.0f;
+
 /**
  * @brief The engine is responsible for the camera, world and events.
  */
@@ -65,8 +77,8 @@ public:
     void keyPress(sf::Event::KeyEvent e);
 
     /**
-     * @brief Update the engine.
-     * @param dt = Delta time.
+     * @brief Update the engine, runs as many fixed simulation steps as the frame time requires.
+     * @param dt = Delta time of the frame.
      */
     void update(const r32 dt);
 
@@ -78,36 +90,6 @@ public:
 
 private:
 
-    /**
-     * @brief The average time it takes to render one frame.
-     */
-    r32 m_avgRenderTime;
-
-    /**
-     * @brief The counter used to keep track of the number of values in the render time accumulator.
-     */
-    r32 m_avgRenderCounter;
-
-    /**
-     * @brief The accumulator used to keep track of the average render time.
-     */
-    r32 m_avgRenderAcc;
-
-    /**
-     * @brief The average time it takes to update one frame.
-     */
-    r32 m_avgUpdateTime;
-
-    /**
-     * @brief The counter used to keep track of the number of the values in the update time accumulator.
-     */
-    r32 m_avgUpdateCounter;
-
-    /**
-     * @brief The accumulator used to keep track of the average update time.
-     */
-    r32 m_avgUpdateAcc;
-
     /**
      * @brief The last fps value measured.
      */
@@ -138,6 +120,11 @@ private:
      */
     sf::Text* m_debugText;
 
+    /**
+     * @brief Used to display the profiler timings.
+     */
+    sf::Text* m_profileText;
+
     /**
      * @brief The camera used to control the view of the world.
      */
@@ -154,24 +141,24 @@ private:
     sf::Shader* m_shader;
 
     /**
-     * @brief The approximate render time.
+     * @brief This clock limits the amout of times we update the debug clock.
      */
-    sf::Clock m_renderTimer;
+    sf::Clock m_debugTextTimer;
 
     /**
-     * @brief The approximate update time.
+     * @brief The world which the entities live in.
      */
-    sf::Clock m_updateTimer;
+    World m_world;
 
     /**
-     * @brief This clock limits the amout of times we update the debug clock.
+     * @brief Draws the world, kept separate so the world can run without a display.
      */
-    sf::Clock m_debugTextTimer;
+    WorldRenderer m_worldRenderer;
 
     /**
-     * @brief The world which the entities live in.
+     * @brief Decides how many fixed simulation steps to run for each frame.
      */
-    World m_world;
+    Scheduler m_scheduler;
 
     /**
      * @brief The instance of the irc bot.
@@ -187,6 +174,13 @@ private:
      * @brief Update the debug info.
      */
     void updateDebugInfo();
+
+    /**
+     * @brief Write the recent timings of a profiler zone to the debug info.
+     * @param str = The stream to write to.
+     * @param zone = The zone to write.
+     */
+    void writeZoneStats(std::stringstream& str, ProfileZone zone);
 };
 
 #endif // ENGINE_H_INCLUDE
@@ -0,0 +1,164 @@
+// Turns a recorded event file into csv tables for offline analysis.
+// Usage: cell-events [event file] [output prefix]
+// One table is written per event type, births.csv, deaths.csv, consumption.csv and collisions.csv,
+// each with a fixed set of typed columns so they load straight into a dataframe.
+// The output prefix is put in front of each file name, it defaults to the folder of the event file.
+
+#include "simulation/eventstream.h"
+#include "simulation/resource.h"
+
+#include <util/log.h>
+#include <util/mappedfile.h>
+
+#include <cstring>
+#include <fstream>
+#include <string>
+
+/**
+ * @brief Get the csv name of a death cause.
+ * @param cause = The cause.
+ * @return The name of the cause.
+ */
+static const char* getCauseName(u8 cause)
+{
+    switch (cause) {
+    case event::Starved: return "starved";
+    case event::Eaten: return "eaten";
+    case event::Depleted: return "depleted";
+    default: return "unknown";
+    }
+}
+
+/**
+ * @brief Get the csv name of a resource type.
+ * @param resourceType = The resource type.
+ * @return The name of the resource type.
+ */
+static const char* getResourceName(u8 resourceType)
+{
+    switch (resourceType) {
+    case type::Food: return "food";
+    case type::Water: return "water";
+    case type::Fire: return "fire";
+    default: return "unknown";
+    }
+}
+
+/**
+ * @brief Open a csv table and write its column names.
+ * @param out = The stream to open.
+ * @param filePath = The path of the table.
+ * @param columns = The column names line.
+ * @return True if sucessful.
+ */
+static bool openTable(std::ofstream& out, const std::string& filePath, const char* columns)
+{
+    out.open(filePath.c_str(), std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        Log::error("failed to write: ", filePath);
+        return false;
+    }
+
+    out << columns << '\n';
+    return true;
+}
+
+int main(int argc, char* args[])
+{
+    const std::string eventPath = (argc > 1) ? args[1] : EVENT_FILE_PATH;
+
+    std::string prefix;
+    if (argc > 2) {
+        prefix = args[2];
+    }
+    else {
+        const std::string::size_type slash = eventPath.find_last_of("/\\");
+        prefix = (slash == std::string::npos) ? std::string() : eventPath.substr(0, slash + 1);
+    }
+
+    MappedFile file;
+    if (!file.open(eventPath)) {
+        Log::error("failed to open the event file: ", eventPath);
+        return -1;
+    }
+
+    EventHeader header;
+    if (file.getSize() < sizeof(header)) {
+        Log::error("the event file is too small: ", eventPath);
+        return -1;
+    }
+
+    std::memcpy(&header, file.getData(), sizeof(header));
+
+    if (std::memcmp(header.magic, EVENT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != EVENT_VERSION || header.recordSize != sizeof(EventRecord)) {
+        Log::error("unknown event file format: ", eventPath);
+        return -1;
+    }
+
+    std::ofstream births, deaths, consumption, collisions;
+
+    if (!openTable(births, prefix + "births.csv", "tick,id,parent,generation") ||
+        !openTable(deaths, prefix + "deaths.csv", "tick,id,cause") ||
+        !openTable(consumption, prefix + "consumption.csv", "tick,cell,resource,resource_type,amount") ||
+        !openTable(collisions, prefix + "collisions.csv", "tick,entity,other")) {
+        return -1;
+    }
+
+    const u64 recordCount = (file.getSize() - sizeof(header)) / sizeof(EventRecord);
+    const char* records = file.getData() + sizeof(header);
+
+    u64 counts[5] = { 0, 0, 0, 0, 0 };
+    u64 tick = 0;
+
+    for (u64 i = 0; i < recordCount; i++) {
+
+        // The records are copied out since the mapping has no alignment guarantee past the header.
+        EventRecord record;
+        std::memcpy(&record, records + (i * sizeof(EventRecord)), sizeof(record));
+
+        switch (record.type) {
+        case event::Tick:
+            tick = (u64)record.entity | ((u64)record.other << 32);
+            break;
+
+        case event::Birth:
+            births << tick << ',' << record.entity << ',';
+            if (record.other != NO_ENTITY)
+                births << record.other;
+            births << ',' << (i32)record.data << '\n';
+            break;
+
+        case event::Death:
+            deaths << tick << ',' << record.entity << ',' << getCauseName(record.detail) << '\n';
+            break;
+
+        case event::Consume: {
+            r32 amount;
+            std::memcpy(&amount, &record.data, sizeof(amount));
+            consumption << tick << ',' << record.entity << ',' << record.other << ',';
+            consumption << getResourceName(record.detail) << ',' << amount << '\n';
+            break;
+        }
+
+        case event::Collision:
+            collisions << tick << ',' << record.entity << ',' << record.other << '\n';
+            break;
+
+        default:
+            Log::warn("skipping an unknown event type: ", (u32)record.type);
+            continue;
+        }
+
+        counts[record.type]++;
+    }
+
+    // A run that was killed can leave part of a record at the end.
+    if ((file.getSize() - sizeof(header)) % sizeof(EventRecord) != 0)
+        Log::warn("the event file ends with a partial record, it was ignored");
+
+    Log::info("ticks with events: ", counts[event::Tick], ", births: ", counts[event::Birth], ", deaths: ", counts[event::Death],
+              ", consumption: ", counts[event::Consume], ", collisions: ", counts[event::Collision]);
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+// Runs the simulation as fast as possible without a window or a gl context.
+// Usage: cell-simulation-headless [ticks] [dt] [threads] [seed] [checkpoint interval] [checkpoint retention] [trace ticks] [events] [resume] [kernel]
+// The same seed and saved state always give the same run, whatever the thread count, on the same network kernel.
+// The kernels round differently, so the kernel picked for the cpu changes the run from one machine to the next.
+// Kernel scalar gives the same run on every cpu, auto, the default, picks the fastest (avx2, neon, sse or scalar).
+// A tick count of zero runs until interrupted, the state is saved on exit either way.
+// A snapshot of the whole world is saved on exit too. Resume 1 carries on the last run from it,
+// or from its newest checkpoint if it never got to exit, with the seed of that run instead of the given one.
+// Resume 0, the default, starts a fresh run with the given seed.
+// A trace tick count records the first ticks into a chrome trace_event file.
+// Events 1 records the births, deaths and consumption into the event file, 2 adds the collisions.
+
+#include "simulation/world.h"
+#include "allocationcounter.h"
+#include "simulation/genetics/genomepool.h"
+
+#include <util/log.h>
+#include <util/profiler.h>
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <sstream>
+
+const std::string LOG_FILE_PATH = "../../data/log.txt";
+
+// How often the tick rate is written to the log.
+const u64 REPORT_INTERVAL = 1000;
+
+static volatile std::sig_atomic_t running = 1;
+
+void onSignal(int)
+{
+    running = 0;
+}
+
+int main(int argc, char* args[])
+{
+    const u64 ticks = (argc > 1) ? std::strtoull(args[1], 0, 10) : 0;
+    const r32 dt = (argc > 2) ? (r32)std::atof(args[2]) : (1.0f / 60.0f);
+    const u32 threads = (argc > 3) ? (u32)std::strtoul(args[3], 0, 10) : 0;
+    const u64 seed = (argc > 4) ? std::strtoull(args[4], 0, 10) : DEFAULT_SEED;
+    const u64 checkpointInterval = (argc > 5) ? std::strtoull(args[5], 0, 10) : 0;
+    const u32 checkpointRetention = (argc > 6) ? (u32)std::strtoul(args[6], 0, 10) : 3;
+    const u64 traceTicks = (argc > 7) ? std::strtoull(args[7], 0, 10) : 0;
+    const u32 events = (argc > 8) ? (u32)std::strtoul(args[8], 0, 10) : 0;
+    const bool resume = (argc > 9) ? std::strtoul(args[9], 0, 10) != 0 : false;
+    const std::string kernel = (argc > 10) ? args[10] : "auto";
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    Log::initialize(LOG_FILE_PATH);
+
+    World world;
+    world.setThreadCount(threads);
+    world.setSeed(seed);
+
+    if (!world.setKernel(kernel))
+        return -1;
+    world.setCheckpoints(checkpointInterval, checkpointRetention);
+
+    // Opened before the world is set up so the starting population is recorded too.
+    if (events > 0)
+        world.getEvents().open(EVENT_FILE_PATH, events > 1);
+
+    if (!world.initialize(resume)) {
+        Log::error("failed to initialize the world");
+        return -1;
+    }
+
+    if (traceTicks > 0)
+        Profiler::startTrace(TRACE_FILE_PATH, traceTicks);
+
+    typedef std::chrono::steady_clock clock;
+
+    const clock::time_point start = clock::now();
+    clock::time_point reportStart = start;
+    u64 reportAllocations = AllocationCounter::getCount();
+
+    u64 tick = 0;
+    while (running && (ticks == 0 || tick < ticks)) {
+
+        world.update(dt);
+        tick++;
+
+        if (tick % REPORT_INTERVAL == 0) {
+
+            const clock::time_point now = clock::now();
+            const r64 elapsed = std::chrono::duration<r64>(now - reportStart).count();
+            reportStart = now;
+
+            const u64 allocations = AllocationCounter::getCount();
+            const u64 tickAllocations = allocations - reportAllocations;
+            reportAllocations = allocations;
+
+            std::stringstream sb;
+            sb << "tick: " << tick;
+            sb << ", ticks/sec: " << (REPORT_INTERVAL / elapsed);
+            sb << ", entities: " << world.getEntityCount();
+            sb << ", cells: " << world.getCellCount();
+            sb << ", allocs/tick: " << ((r64)tickAllocations / REPORT_INTERVAL);
+
+            const Checkpointer& checkpointer = world.getCheckpointer();
+            if (checkpointer.getInterval() > 0) {
+                sb << ", checkpoints: " << checkpointer.getWrittenCount();
+                sb << " (skipped " << checkpointer.getSkippedCount() << ")";
+                sb << ", capture ms: " << (checkpointer.getCaptureTime() * 1000.0);
+                sb << ", latency ms: " << (checkpointer.getLatency() * 1000.0);
+            }
+            Log::info(sb.str());
+        }
+    }
+
+    const r64 total = std::chrono::duration<r64>(clock::now() - start).count();
+
+    std::stringstream sb;
+    sb << "ran " << tick << " ticks in " << total << "s on " << world.getThreadCount() << " threads";
+    sb << " (" << (total > 0.0 ? tick / total : 0.0) << " ticks/sec)";
+    Log::info(sb.str());
+
+    const EntityStoreStats pools = world.getStore().getStats();
+
+    std::stringstream store;
+    store << "entity pools (count/high water/capacity): ";
+    store << "entities " << pools.entities.count << "/" << pools.entities.highWater << "/" << pools.entities.capacity;
+    store << ", cells " << pools.cells.count << "/" << pools.cells.highWater << "/" << pools.cells.capacity;
+    store << ", food " << pools.food.count << "/" << pools.food.highWater << "/" << pools.food.capacity;
+    store << ", fire " << pools.fire.count << "/" << pools.fire.highWater << "/" << pools.fire.capacity;
+    store << ", free slots " << pools.freeSlotCount << " of " << pools.slotCount;
+    Log::info(store.str());
+
+    const GenomePoolStats genomes = GenomePool::getStats();
+
+    std::stringstream pool;
+    pool << "genome pool: " << genomes.usedCount << " of " << genomes.blockCount << " blocks in use";
+    pool << ", high water: " << genomes.highWater << ", block size: " << genomes.blockSize;
+    Log::info(pool.str());
+
+    for (ProfileZone zone = 0; zone < Profiler::getZoneCount(); zone++) {
+
+        const ZoneStats stats = Profiler::getStats(zone);
+        if (stats.count == 0)
+            continue;
+
+        std::stringstream timing;
+        timing << "zone " << stats.name << " ms (p50/p99/max): " << stats.p50 << "/" << stats.p99 << "/" << stats.max;
+        timing << ", count: " << stats.count;
+        Log::info(timing.str());
+    }
+
+    world.destroy();
+    Log::destroy();
+
+    return 0;
+}
@@ -0,0 +1,27 @@
+#include "vertexbatch.h"
+
+VertexBatch::VertexBatch(sf::PrimitiveType primitiveType) :
+    m_primitiveType(primitiveType),
+    m_buffer(primitiveType, sf::VertexBuffer::Stream)
+{ }
+
+void VertexBatch::draw(sf::RenderTarget& target, const sf::RenderStates& states)
+{
+    if (m_vertices.empty())
+        return;
+
+    // Grow the buffer with some room to spare so it isn't recreated every time an entity is born.
+    if (sf::VertexBuffer::isAvailable() && m_buffer.getVertexCount() < m_vertices.size()) {
+        m_buffer.create(m_vertices.size() + (m_vertices.size() / 2));
+    }
+
+    // Draw straight from memory without vertex buffers, or if the buffer couldn't be created.
+    if (m_buffer.getVertexCount() < m_vertices.size()) {
+        target.draw(m_vertices.data(), m_vertices.size(), m_primitiveType, states);
+        return;
+    }
+
+    m_buffer.update(m_vertices.data(), m_vertices.size(), 0);
+
+    target.draw(m_buffer, 0, m_vertices.size(), states);
+}
@@ -0,0 +1,72 @@
+#ifndef VERTEXBATCH_H_INCLUDE
+#define VERTEXBATCH_H_INCLUDE
+
+// Standard includes.
+#include <vector>
+
+// SFML includes.
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+
+/**
+ * @brief Collects the vertices of many shapes of one primitive type and draws them in one call.
+ *
+ * The vertices are rebuilt on the cpu every frame and uploaded into a vertex buffer that is
+ * kept between frames, it only grows so once it is big enough no gpu memory is allocated.
+ * When vertex buffers are not available the vertices are drawn straight from memory instead.
+ */
+class VertexBatch
+{
+public:
+
+    /**
+     * @brief Create an empty batch.
+     * @param primitiveType = The type of primitive the vertices make up.
+     */
+    explicit VertexBatch(sf::PrimitiveType primitiveType);
+
+    /**
+     * @brief Remove all of the vertices, the memory is kept for the next frame.
+     */
+    void clear() { m_vertices.clear(); }
+
+    /**
+     * @brief Add a vertex to the batch.
+     * @param vertex = The vertex to add.
+     */
+    void append(const sf::Vertex& vertex) { m_vertices.push_back(vertex); }
+
+    /**
+     * @brief Get the number of vertices in the batch.
+     * @return The vertex count.
+     */
+    std::size_t getVertexCount() const { return m_vertices.size(); }
+
+    /**
+     * @brief Upload the vertices and draw them in one call.
+     * @param target = The target to draw to.
+     * @param states = The states to draw with.
+     */
+    void draw(sf::RenderTarget& target, const sf::RenderStates& states);
+
+private:
+
+    /**
+     * @brief The type of primitive the vertices make up.
+     */
+    sf::PrimitiveType m_primitiveType;
+
+    /**
+     * @brief The vertices built this frame.
+     */
+    std::vector<sf::Vertex> m_vertices;
+
+    /**
+     * @brief The gpu buffer the vertices are uploaded to.
+     */
+    sf::VertexBuffer m_buffer;
+};
+
+#endif // VERTEXBATCH_H_INCLUDE
@@ -0,0 +1,406 @@
+#include "worldrenderer.h"
+
+#include "../core/content.h"
+#include "../simulation/cell.h"
+#include "../simulation/resource.h"
+#include "../simulation/entitystore.h"
+
+#include <scl/math/help.h>
+#include <util/profiler.h>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+static const ProfileZone RENDER_GRID_ZONE = Profiler::addZone("render grid");
+static const ProfileZone RENDER_BUILD_ZONE = Profiler::addZone("render build");
+static const ProfileZone RENDER_DRAW_ZONE = Profiler::addZone("render draw");
+
+WorldRenderer::WorldRenderer() :
+    m_debug(false),
+    m_lastEntityCount(0),
+    m_drawnCount(0),
+    m_heatmap(false),
+    m_heatmapCellCount(0),
+    m_culledCount(0),
+    m_shapes(sf::Triangles),
+    m_points(sf::Points),
+    m_lines(sf::Lines),
+    m_bars(sf::Lines),
+    m_debugText(0)
+{
+    std::fill(m_detailCounts, m_detailCounts + detail::Count, 0);
+
+    m_unitCircle.resize(ENTITY_CIRCLE_POINTS + 1);
+
+    // The last point closes the circle so the loops never have to wrap around.
+    for (u32 i = 0; i <= ENTITY_CIRCLE_POINTS; i++) {
+        const r32 radians = (Pi * 2.0f) * ((r32)i / ENTITY_CIRCLE_POINTS);
+        m_unitCircle[i] = vec2f(std::cos(radians), std::sin(radians));
+    }
+}
+
+bool WorldRenderer::initialize(const World& world)
+{
+    const r32 radius = world.getRadius();
+
+    m_border.setRadius(radius);
+    m_border.setOrigin(radius, radius);
+    m_border.setFillColor(sf::Color(32, 32, 32, 255));
+    m_border.setOutlineColor(sf::Color(128, 128, 128, 255));
+    m_border.setOutlineThickness(10.0f);
+    m_border.setPointCount(100);
+
+    m_vertexQuadArray.setPrimitiveType(sf::Quads);
+    m_vertexLineArray.setPrimitiveType(sf::Lines);
+
+    m_debugText = new sf::Text();
+    m_debugText->setFont(*Content::font);
+    m_debugText->setPosition(0.0f, 100.0f);
+    m_debugText->setCharacterSize(16);
+
+    updateEntityText(world);
+
+    return true;
+}
+
+void WorldRenderer::destroy()
+{
+    if (m_debugText)
+        delete m_debugText;
+
+    m_debugText = 0;
+}
+
+void WorldRenderer::render(sf::RenderTarget& target, World& world, Camera& camera, const sf::View& textView, const r32 alpha)
+{
+    // Setup the camera view for the world
+    camera.render(target);
+
+    target.draw(m_border, Content::shader);
+
+    if (m_debug) {
+        ProfileScope zone(RENDER_GRID_ZONE);
+
+        buildGridArrays(world);
+        target.draw(m_vertexQuadArray, Content::shader);
+        target.draw(m_vertexLineArray, Content::shader);
+    }
+
+    const EntityStore& store = world.getStore();
+
+    m_shapes.clear();
+    m_points.clear();
+    m_lines.clear();
+    m_bars.clear();
+
+    // Only look at the grid cells under the view. The grid stores entities by their center so
+    // widen the view by the furthest any part of an entity can reach, the vision lines.
+    const sf::View& view = target.getView();
+    const sf::Vector2f viewCenter = view.getCenter();
+    const sf::Vector2f viewSize = view.getSize();
+
+    rectf viewBounds;
+    viewBounds.x = viewCenter.x - (viewSize.x * 0.5f);
+    viewBounds.y = viewCenter.y - (viewSize.y * 0.5f);
+    viewBounds.width = viewSize.x;
+    viewBounds.height = viewSize.y;
+
+    rectf searchBounds;
+    searchBounds.x = viewBounds.x - maxEyeLength;
+    searchBounds.y = viewBounds.y - maxEyeLength;
+    searchBounds.width = viewBounds.width + (maxEyeLength * 2.0f);
+    searchBounds.height = viewBounds.height + (maxEyeLength * 2.0f);
+
+    // The number of pixels per world unit picks how much detail is worth drawing.
+    const r32 scale = target.getSize().x / viewSize.x;
+
+    const bool heatmap = (scale * GRID_CELL_SIZE) < HEATMAP_CELL_PIXELS;
+
+    u32 detailCounts[detail::Count] = { 0, 0, 0 };
+    u32 drawnCount = 0;
+    u32 culledCount = 0;
+    u32 heatmapCellCount = 0;
+
+    {
+        ProfileScope zone(RENDER_BUILD_ZONE);
+
+        if (heatmap) {
+            heatmapCellCount = buildHeatmap(world, viewBounds);
+        }
+        else {
+            world.getSpatialGrid().forEachInRect(searchBounds, [&](u32 index) {
+
+                if (!store.alive[index])
+                    return;
+
+                const vec2f location = store.getInterpolatedLocation(index, alpha);
+
+                if (isEntityVisible(store, index, location, viewBounds)) {
+                    detailCounts[buildEntity(store, index, location, scale)]++;
+                    drawnCount++;
+                }
+                else {
+                    culledCount++;
+                }
+            });
+        }
+    }
+
+    {
+        ProfileScope zone(RENDER_DRAW_ZONE);
+
+        m_shapes.draw(target, Content::shader);
+        m_points.draw(target, Content::shader);
+        m_lines.draw(target, Content::shader);
+        m_bars.draw(target, Content::shader);
+    }
+
+    if (world.getEntityCount() != m_lastEntityCount || drawnCount != m_drawnCount ||
+        culledCount != m_culledCount || heatmap != m_heatmap || heatmapCellCount != m_heatmapCellCount ||
+        !std::equal(detailCounts, detailCounts + detail::Count, m_detailCounts)) {
+
+        m_drawnCount = drawnCount;
+        m_culledCount = culledCount;
+        m_heatmap = heatmap;
+        m_heatmapCellCount = heatmapCellCount;
+        std::copy(detailCounts, detailCounts + detail::Count, m_detailCounts);
+
+        updateEntityText(world);
+    }
+
+    target.setView(textView);
+    target.draw(*m_debugText);
+}
+
+bool WorldRenderer::isEntityVisible(const EntityStore& store, u32 index, const vec2f& location, const rectf& view) const
+{
+    // The food bar sits just outside the entity.
+    r32 reach = store.radius[index] + 2.0f;
+
+    if (store.type[index] == EntityType::Cell) {
+        const Traits& traits = store.cells.dna[store.component[index]].traits;
+        reach = std::max(reach, std::max(traits.eyeLengthA, std::max(traits.eyeLengthB, traits.eyeLengthC)));
+    }
+
+    return location.x + reach >= view.x && location.x - reach <= view.x + view.width &&
+           location.y + reach >= view.y && location.y - reach <= view.y + view.height;
+}
+
+detail::EntityDetail WorldRenderer::buildEntity(const EntityStore& store, u32 index, const vec2f& location, const r32 scale)
+{
+    const r32 radius = store.radius[index];
+
+    sf::Color color;
+
+    if (store.type[index] == EntityType::Cell) {
+        const vec3f cellColor = store.color[index];
+        color = sf::Color(cellColor.x * 255, cellColor.y * 255, cellColor.z * 255, 255);
+    }
+    else if (store.resources.resourceType[store.component[index]] == type::Fire) {
+        color = sf::Color::Red;
+    }
+    else {
+        color = sf::Color(25, 255, 25);
+    }
+
+    const r32 screenRadius = radius * scale;
+
+    if (screenRadius < POINT_DETAIL_PIXELS) {
+        m_points.append(sf::Vertex(sf::Vector2f(location.x, location.y), color));
+        return detail::Point;
+    }
+
+    if (screenRadius < FULL_DETAIL_PIXELS) {
+        buildCircle(location, radius, color, LOW_DETAIL_CIRCLE_POINTS);
+        return detail::Low;
+    }
+
+    buildCircle(location, radius, color, ENTITY_CIRCLE_POINTS);
+
+    if (store.type[index] == EntityType::Cell) {
+        const u32 cell = store.component[index];
+
+        buildDebugLines(store, index, location);
+        buildRoundBar(location, radius, sf::Color::Green, store.cells.foodAmount[cell], 2.0f);
+    }
+
+    return detail::Full;
+}
+
+void WorldRenderer::buildCircle(const vec2f& location, const r32 radius, const sf::Color color, const u32 pointCount)
+{
+    const sf::Vector2f center(location.x, location.y);
+    const u32 stride = ENTITY_CIRCLE_POINTS / pointCount;
+
+    for (u32 i = 0; i < ENTITY_CIRCLE_POINTS; i += stride) {
+
+        const vec2f a = location + (m_unitCircle[i] * radius);
+        const vec2f b = location + (m_unitCircle[i + stride] * radius);
+
+        m_shapes.append(sf::Vertex(center, color));
+        m_shapes.append(sf::Vertex(sf::Vector2f(a.x, a.y), color));
+        m_shapes.append(sf::Vertex(sf::Vector2f(b.x, b.y), color));
+    }
+}
+
+void WorldRenderer::buildDebugLines(const EntityStore& store, u32 index, const vec2f& location)
+{
+    const vec2f velocity = store.velocity[index];
+
+    // The vision lines are only worked out for the cells drawn in full, from where they are drawn.
+    VisionLines visionLines;
+    Cell::calculateVisionLines(store, store.component[index], location, visionLines);
+
+    const vec2f visionA = visionLines.points[0];
+    const vec2f visionB = visionLines.points[1];
+    const vec2f visionC = visionLines.points[2];
+
+    r32 length = (velocity.length() / 500.0f) + 8.0f;
+    vec2f newPoint = (length) * vec2f::normalizeOrZero(velocity);
+
+    sf::Vector2f pointA(location.x, location.y);
+    sf::Vector2f pointB(newPoint.x, newPoint.y);
+
+    m_lines.append(sf::Vertex(pointA, sf::Color::Red));
+    m_lines.append(sf::Vertex(pointA + pointB, sf::Color::Red));
+
+    m_lines.append(sf::Vertex(pointA, sf::Color::Cyan));
+    m_lines.append(sf::Vertex(sf::Vector2f(visionA.x, visionA.y), sf::Color::Cyan));
+
+    m_lines.append(sf::Vertex(pointA, sf::Color::Green));
+    m_lines.append(sf::Vertex(sf::Vector2f(visionB.x, visionB.y), sf::Color::Green));
+
+    m_lines.append(sf::Vertex(pointA, sf::Color::Blue));
+    m_lines.append(sf::Vertex(sf::Vector2f(visionC.x, visionC.y), sf::Color::Blue));
+}
+
+void WorldRenderer::buildRoundBar(const vec2f& location, const r32 radius, const sf::Color color, const r32 value, const r32 offset)
+{
+    // The bar steps around the shared unit circle, skipping points to get the bar segments.
+    const u32 stride = ENTITY_CIRCLE_POINTS / FOOD_BAR_SEGMENTS;
+    const u32 segments = (u32)(clamp(value / CELL_MAX_FOOD, 0.0f, 1.0f) * FOOD_BAR_SEGMENTS);
+
+    const r32 barRadius = radius + offset;
+
+    for (u32 i = 0; i < segments; i++) {
+
+        const vec2f a = location + (m_unitCircle[i * stride] * barRadius);
+        const vec2f b = location + (m_unitCircle[(i + 1) * stride] * barRadius);
+
+        m_bars.append(sf::Vertex(sf::Vector2f(a.x, a.y), color));
+        m_bars.append(sf::Vertex(sf::Vector2f(b.x, b.y), color));
+    }
+}
+
+u32 WorldRenderer::buildHeatmap(const World& world, const rectf& view)
+{
+    const SpatialGrid& grid = world.getSpatialGrid();
+
+    u32 cellCount = 0;
+
+    u32 maxCount = 1;
+    for (i32 y = 0; y < grid.getSize(); y++) {
+        for (i32 x = 0; x < grid.getSize(); x++) {
+            maxCount = std::max(maxCount, grid.getCellEntityCount(x, y));
+        }
+    }
+
+    for (i32 y = 0; y < grid.getSize(); y++) {
+        for (i32 x = 0; x < grid.getSize(); x++) {
+
+            const u32 count = grid.getCellEntityCount(x, y);
+            const rectf bounds = grid.getCellBounds(x, y);
+
+            if (count == 0 ||
+                bounds.x + bounds.width < view.x || bounds.x > view.x + view.width ||
+                bounds.y + bounds.height < view.y || bounds.y > view.y + view.height) {
+                continue;
+            }
+
+            // Blend from a dim blue for the sparse cells to a bright orange for the busiest.
+            const r32 density = (r32)count / maxCount;
+            const sf::Color color(32 + (223 * density), 32 + (96 * density), 128 * (1.0f - density));
+
+            sf::Vector2f a(bounds.x, bounds.y);
+            sf::Vector2f b(bounds.x + bounds.width, bounds.y);
+            sf::Vector2f c(bounds.x + bounds.width, bounds.y + bounds.height);
+            sf::Vector2f d(bounds.x, bounds.y + bounds.height);
+
+            m_shapes.append(sf::Vertex(a, color));
+            m_shapes.append(sf::Vertex(b, color));
+            m_shapes.append(sf::Vertex(c, color));
+
+            m_shapes.append(sf::Vertex(a, color));
+            m_shapes.append(sf::Vertex(c, color));
+            m_shapes.append(sf::Vertex(d, color));
+
+            cellCount++;
+        }
+    }
+
+    return cellCount;
+}
+
+void WorldRenderer::buildGridArrays(World& world)
+{
+    m_vertexQuadArray.clear();
+    m_vertexLineArray.clear();
+
+    const SpatialGrid& grid = world.getSpatialGrid();
+
+    for (i32 y = 0; y < grid.getSize(); y++) {
+        for (i32 x = 0; x < grid.getSize(); x++) {
+
+            const rectf bounds = grid.getCellBounds(x, y);
+
+            sf::Vector2f a(bounds.x, bounds.y);
+            sf::Vector2f b(bounds.x + bounds.width, bounds.y);
+            sf::Vector2f c(bounds.x + bounds.width, bounds.y + bounds.height);
+            sf::Vector2f d(bounds.x, bounds.y + bounds.height);
+
+            sf::Color color = sf::Color(32, 32, 32);
+
+            if (grid.getCellEntityCount(x, y) > 0) {
+                color = sf::Color(128, 128, 128);
+            }
+
+            m_vertexQuadArray.append(sf::Vertex(a, color));
+            m_vertexQuadArray.append(sf::Vertex(b, color));
+            m_vertexQuadArray.append(sf::Vertex(c, color));
+            m_vertexQuadArray.append(sf::Vertex(d, color));
+
+            m_vertexLineArray.append(sf::Vertex(a, sf::Color::Blue));
+            m_vertexLineArray.append(sf::Vertex(b, sf::Color::Blue));
+
+            m_vertexLineArray.append(sf::Vertex(b, sf::Color::Blue));
+            m_vertexLineArray.append(sf::Vertex(c, sf::Color::Blue));
+
+            m_vertexLineArray.append(sf::Vertex(c, sf::Color::Blue));
+            m_vertexLineArray.append(sf::Vertex(d, sf::Color::Blue));
+
+            m_vertexLineArray.append(sf::Vertex(d, sf::Color::Blue));
+            m_vertexLineArray.append(sf::Vertex(a, sf::Color::Blue));
+        }
+    }
+}
+
+void WorldRenderer::updateEntityText(const World& world)
+{
+    m_lastEntityCount = world.getEntityCount();
+
+    std::stringstream sb;
+    sb << "entity count: " << m_lastEntityCount << std::endl;
+    sb << "cell count: " << world.getCellCount() << std::endl;
+
+    // The heatmap is drawn from the grid counts, no entity is drawn or culled on its own.
+    if (m_heatmap) {
+        sb << "detail: heatmap, grid cells shaded: " << m_heatmapCellCount;
+    }
+    else {
+        sb << "drawn: " << m_drawnCount << ", culled: " << m_culledCount << std::endl;
+        sb << "detail (full/low/point): " << m_detailCounts[detail::Full];
+        sb << "/" << m_detailCounts[detail::Low] << "/" << m_detailCounts[detail::Point];
+    }
+    m_debugText->setString(sb.str());
+}
@@ -0,0 +1,264 @@
+#ifndef WORLDRENDERER_H_INCLUDE
+#define WORLDRENDERER_H_INCLUDE
+
+// SFML includes.
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/CircleShape.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include <scl/types.h>
+
+// Standard includes.
+#include <vector>
+
+// Project includes.
+#include "vertexbatch.h"
+#include "../core/camera.h"
+#include "../simulation/world.h"
+
+/**
+ * @brief The number of points around the outline of an entity.
+ */
+const u32 ENTITY_CIRCLE_POINTS = 32;
+
+/**
+ * @brief The number of points around the outline of an entity drawn at low detail.
+ */
+const u32 LOW_DETAIL_CIRCLE_POINTS = 8;
+
+/**
+ * @brief The number of segments in a full food bar.
+ */
+const u32 FOOD_BAR_SEGMENTS = 16;
+
+/**
+ * @brief Entities with a smaller radius on screen than this are drawn as a single point.
+ */
+const r32 POINT_DETAIL_PIXELS = 2.0f;
+
+/**
+ * @brief Entities with a larger radius on screen than this are drawn in full, with their food bar and vision lines.
+ */
+const r32 FULL_DETAIL_PIXELS = 12.0f;
+
+/**
+ * @brief When a grid cell is smaller than this on screen the entities are replaced with a density heatmap of the grid.
+ */
+const r32 HEATMAP_CELL_PIXELS = 4.0f;
+
+namespace detail {
+
+/**
+ * @brief How much of an entity is drawn, picked by its size on screen.
+ */
+enum EntityDetail
+{
+    Point = 0,
+    Low = 1,
+    Full = 2,
+    Count = 3,
+};
+
+}
+
+/**
+ * @brief Draws the state of a world, the world itself knows nothing about rendering.
+ * The entities, the debug lines and the food bars are each built into one batch per frame
+ * and drawn with a single call.
+ */
+class WorldRenderer
+{
+public:
+
+    /**
+     * @brief The default world renderer constructor.
+     */
+    WorldRenderer();
+
+    /**
+     * @brief Initialize the renderer, requires the content to be loaded.
+     * @param world = The world that will be rendered.
+     * @return True if sucessful.
+     */
+    bool initialize(const World& world);
+
+    /**
+     * @brief Destroy any loaded content.
+     */
+    void destroy();
+
+    /**
+     * @brief Render the world.
+     * @param target = Target to render to.
+     * @param world = The world to render.
+     * @param camera = The camera used to view the world.
+     * @param textView = The view used to render text.
+     * @param alpha = The blend factor between the previous and the current simulation step.
+     */
+    void render(sf::RenderTarget& target, World& world, Camera& camera, const sf::View& textView, const r32 alpha);
+
+    /**
+     * @brief Enable or disable the debug data.
+     * @param debug = The new debug state.
+     */
+    void setDebug(bool debug) { m_debug = debug; }
+
+    /**
+     * @brief Get the current debugging state of the renderer.
+     * @return The current debugging state.
+     */
+    bool getDebug() const { return m_debug; }
+
+private:
+
+    /**
+     * @brief Show the debug grid or not.
+     */
+    bool m_debug;
+
+    /**
+     * @brief The entity count shown in the debug text the last time it was updated.
+     */
+    u32 m_lastEntityCount;
+
+    /**
+     * @brief The number of entities drawn in the last frame.
+     */
+    u32 m_drawnCount;
+
+    /**
+     * @brief The number of entities drawn at each level of detail in the last frame.
+     */
+    u32 m_detailCounts[detail::Count];
+
+    /**
+     * @brief Set when the last frame was drawn as a heatmap.
+     */
+    bool m_heatmap;
+
+    /**
+     * @brief The number of grid cells shaded in the last heatmap frame.
+     */
+    u32 m_heatmapCellCount;
+
+    /**
+     * @brief The number of entities near the view that were tested and left out of the last frame because they were off screen.
+     */
+    u32 m_culledCount;
+
+    /**
+     * @brief Used to render the border of the world.
+     */
+    sf::CircleShape m_border;
+
+    /**
+     * @brief The points of a unit circle, shared by every entity outline and food bar.
+     */
+    std::vector<vec2f> m_unitCircle;
+
+    /**
+     * @brief The triangles of every entity, or the heatmap cells.
+     */
+    VertexBatch m_shapes;
+
+    /**
+     * @brief The entities too small to be more than a point.
+     */
+    VertexBatch m_points;
+
+    /**
+     * @brief The direction and vision lines of every cell.
+     */
+    VertexBatch m_lines;
+
+    /**
+     * @brief The food bars of every cell, as line segments.
+     */
+    VertexBatch m_bars;
+
+    /**
+     * @brief The vertex array used for debug rendering.
+     */
+    sf::VertexArray m_vertexQuadArray;
+
+    /**
+     * @brief The vertex array used for debug rendering.
+     */
+    sf::VertexArray m_vertexLineArray;
+
+    /**
+     * @brief The text used to render some special debug information.
+     */
+    sf::Text* m_debugText;
+
+    /**
+     * @brief Check if any part of an entity, its overlays included, is inside the view.
+     * @param store = The store the entity exists in.
+     * @param index = The dense index of the entity.
+     * @param location = The interpolated location of the entity.
+     * @param view = The world space bounds of the view.
+     * @return True if the entity should be drawn.
+     */
+    bool isEntityVisible(const EntityStore& store, u32 index, const vec2f& location, const rectf& view) const;
+
+    /**
+     * @brief Add the geometry of a single entity to the batches.
+     * @param store = The store the entity exists in.
+     * @param index = The dense index of the entity.
+     * @param location = The interpolated location to render the entity at.
+     * @param scale = The number of pixels per world unit.
+     * @return The level of detail the entity was drawn at.
+     */
+    detail::EntityDetail buildEntity(const EntityStore& store, u32 index, const vec2f& location, const r32 scale);
+
+    /**
+     * @brief Add the triangles of a filled circle to the shape batch.
+     * @param location = The center of the circle.
+     * @param radius = The radius of the circle.
+     * @param color = The fill color.
+     * @param pointCount = The number of points around the outline, must divide ENTITY_CIRCLE_POINTS.
+     */
+    void buildCircle(const vec2f& location, const r32 radius, const sf::Color color, const u32 pointCount);
+
+    /**
+     * @brief Add a quad for each grid cell in view, colored by the number of entities in it.
+     * @param world = The world to take the spatial grid from.
+     * @param view = The world space bounds of the view.
+     * @return The number of grid cells shaded.
+     */
+    u32 buildHeatmap(const World& world, const rectf& view);
+
+    /**
+     * @brief Add the direction and vision lines of a cell to the line batch.
+     * @param store = The store the cell exists in.
+     * @param index = The dense index of the cell.
+     * @param location = The interpolated location to render the cell at.
+     */
+    void buildDebugLines(const EntityStore& store, u32 index, const vec2f& location);
+
+    /**
+     * @brief Add a round info bar around an entity to the bar batch.
+     * @param location = The center of the entity.
+     * @param radius = The radius of the entity.
+     * @param color = The color of the bar.
+     * @param value = How full the bar is, out of CELL_MAX_FOOD.
+     * @param offset = The gap between the entity and the bar.
+     */
+    void buildRoundBar(const vec2f& location, const r32 radius, const sf::Color color, const r32 value, const r32 offset);
+
+    /**
+     * @brief Rebuild the vertex data used to debug the spatial grid.
+     * @param world = The world to take the spatial grid from.
+     */
+    void buildGridArrays(World& world);
+
+    /**
+     * @brief Update the entity debug text label, along with the culling counts.
+     * @param world = The world to take the counts from.
+     */
+    void updateEntityText(const World& world);
+};
+
+#endif // WORLDRENDERER_H_INCLUDE
@@ -1,22 +1,18 @@
 #include "cell.h"
 #include "world.h"
+#include "entitystore.h"
 #include "resource.h"
+#include "commandbuffer.h"
 #include "genetics/breeder.h"
 
-#include "../core/console.h"
-#include "../core/content.h"
 #include "../mathutils.h"
 #include "randomgen.h"
 
 #include <scl/math/help.h>
+#include <util/log.h>
 
 #include <iostream>
 #include <limits>
-#include <sstream>
-
-const r32 CELL_MAX_MASS = 100.0f;
-const r32 CELL_MAX_FOOD = 100.0f;
-const r32 CELL_MAX_RADIUS = 30.0f;
 
 r32 IntegerNoise (i32 n)
 {
@@ -25,279 +21,232 @@ r32 IntegerNoise (i32 n)
   return 1.0f - ((r32)nn / 1073741824.0f);
 }
 
-i32 Cell::m_cellCount = 0;
-
-Cell::Cell(i32 generation, DNA dna, vec2f location, World& world) :
-    Entity(location, world, EntityType::Cell),
-    m_generation(generation),
-    m_foodAmount(CELL_MAX_FOOD),
-    m_dna(dna)
+u32 Cell::create(World& world, i32 generation, DNA dna, vec2f location, u32 parent)
 {
-    m_cellCount++;
-
-    m_friction = vec2f(0.95f);
-
-    m_shape.setPointCount(32);
-    m_shape.setPosition(m_location.x, m_location.y);
-    m_shape.setOutlineThickness(0.0f);
+    EntityStore& store = world.getStore();
 
-    m_debugLines.setPrimitiveType(sf::Lines);
-    m_foodBar.setPrimitiveType(sf::LinesStrip);
+    // Only the values are copied here, the log thread builds the line.
+    Log::info("cell split rate: ", dna.traits.splitRate, ", mutation rate: ", dna.traits.mutationRate, ", gen: ", generation);
 
-    m_mass = CELL_MAX_MASS;
+    const vec3f color = vec3f(dna.traits.red, dna.traits.green, dna.traits.blue);
+    const u64 genomeHash = dna.genome.getHash();
 
-    m_shape.setFillColor(sf::Color(m_dna.traits.red * 255, m_dna.traits.green * 255, m_dna.traits.blue * 255, 255));
+    const u32 index = store.addCell(location, std::move(dna));
+    const u32 cell = store.component[index];
 
-    m_color = vec3f(m_dna.traits.red, m_dna.traits.green, m_dna.traits.blue);
+    store.friction[index] = vec2f(0.95f);
+    store.mass[index] = CELL_MAX_MASS;
+    store.color[index] = color;
 
-    m_splitRate = m_dna.traits.splitRate;
+    store.cells.generation[cell] = generation;
 
-    std::stringstream info;
-    info << "cell split rate: " << m_splitRate;
-    info << ", mutation rate: " << m_dna.traits.mutationRate;
-    info << ", gen: " << m_generation;
+    world.getEvents().birth(world.getTick(), store.id[index], parent, generation);
+    world.getLineage().birth(world.getTick(), store.id[index], parent, genomeHash);
 
-    Console::write(info.str());
+    return index;
 }
 
-Cell::~Cell()
+void Cell::sense(World& world, u32 cell, r32* inputs)
 {
-    m_cellCount--;
-}
+    EntityStore& store = world.getStore();
+    const CellComponents& cells = store.cells;
 
-void Cell::update(const float dt)
-{
-    time += dt;
+    const u32 index = cells.entity[cell];
 
-    // All of the entities in the nearby hashnodes.
-    std::vector<Entity*> nearList = getNearEntities(true);
+    const vec2f location = store.location[index];
+    const r32 rotation = store.rotation[index];
 
-    const vec2f closestWallPoint = closestCirclePoint(vec2f(), m_world.getRadius(), m_location);
-    const r32 wallDist = vec2f::distance(closestWallPoint, m_location);
-    const r32 wallDir = m_rotation - vec2f::direction(closestWallPoint, m_location);
+    const vec2f closestWallPoint = closestCirclePoint(vec2f(), world.getRadius(), location);
+    const r32 wallDist = vec2f::distance(closestWallPoint, location);
+    const r32 wallDir = rotation - vec2f::direction(closestWallPoint, location);
 
     //const r32 pi2 = nx::Pi * 2.0f;
-    const r32 worldRadius = m_world.getRadius();
+    const r32 worldRadius = world.getRadius();
 
     r32 visionValues[12];
 
     for (auto& value : visionValues)
         value = 0;
 
-    caculateVisionLines();
-    calculateVision(nearList, visionValues);
+    VisionLines lines;
+    calculateVisionLines(store, cell, location, lines);
+    calculateVision(world, cell, lines, visionValues);
 
-    r32 inputs[19];
-
-    inputs[0] = normalize(m_rotation, -Pi, Pi);
-    inputs[1] = normalize(m_radius, 1.0f, CELL_MAX_RADIUS);
-    inputs[2] = normalize(m_foodAmount, 0.0f, CELL_MAX_FOOD);
+    inputs[0] = normalize(rotation, -Pi, Pi);
+    inputs[1] = normalize(store.radius[index], 1.0f, CELL_MAX_RADIUS);
+    inputs[2] = normalize(cells.foodAmount[cell], 0.0f, CELL_MAX_FOOD);
     inputs[3] = normalize(wallDist, 0.0f, worldRadius);
     inputs[4] = normalize(wallDir, -Pi, Pi);
-    inputs[5] = m_memory[0];
-    inputs[6] = m_memory[1];
+    inputs[5] = cells.memory[cell].x;
+    inputs[6] = cells.memory[cell].y;
 
     for (u32 i = 0; i < 12; i++)
         inputs[i + 7] = visionValues[i];
+}
 
-    NeuralNetwork* network = World::m_neuralNetwork;
-
-    // Pass the genome data into the network.
-
-    // We are not using the first two values.
-    // Since they are the split rate and the mutation rate.
-
-    network->setWeights(m_dna.genome.readWeights());
+void Cell::update(World& world, u32 cell, const r32* outputs, const float dt)
+{
+    EntityStore& store = world.getStore();
+    CellComponents& cells = store.cells;
 
-    // Compute the output values.
-    network->computeOutputs(inputs);
+    const u32 index = cells.entity[cell];
 
-    const r32* output = network->getOutputs();
+    r32& rotation = store.rotation[index];
 
-    const r32 forward = output[0] * 300.f;
-    const r32 turnLeft = output[2];
-    const r32 turnRight = output[3];
+    const r32 forward = outputs[0] * 300.f;
+    const r32 turnLeft = outputs[2];
+    const r32 turnRight = outputs[3];
 
+    // The network only has four outputs, feed the spare output and the last
+    // forward output back in as the memory for the next update.
+    cells.memory[cell] = vec2f(outputs[1], outputs[0]);
 
-    m_memory[0] = output[4];
-    m_memory[1] = output[5];
+    rotation += turnRight / Pi;
+    rotation -= turnLeft / Pi;
 
-    m_rotation += turnRight / Pi;
-    m_rotation -= turnLeft / Pi;
+    store.velocity[index].x += std::cos(rotation) * forward * dt;
+    store.velocity[index].y += std::sin(rotation) * forward * dt;
 
-    m_velocity.x += std::cos(m_rotation) * forward * dt;
-    m_velocity.y += std::sin(m_rotation) * forward * dt;
+    r32& foodAmount = cells.foodAmount[cell];
+    r32& mass = store.mass[index];
 
     // Our constant food loss.
-    m_foodAmount -= 5.0f * dt;
+    foodAmount -= 5.0f * dt;
 
     // Clamp to the specific range.
-    m_foodAmount = clamp(m_foodAmount, 0.0f, CELL_MAX_FOOD);
-    m_mass = clamp(m_mass, 1.0f, CELL_MAX_MASS);
+    foodAmount = clamp(foodAmount, 0.0f, CELL_MAX_FOOD);
+    mass = clamp(mass, 1.0f, CELL_MAX_MASS);
 
     // The cell considered dead when it is out of water, or it has left the world.
-    if (m_foodAmount < 1.0f || m_mass < 2.0f)
-        m_alive = false;
+    if (foodAmount < 1.0f || mass < 2.0f)
+        store.alive[index] = 0;
 
-    m_radius = (m_mass / CELL_MAX_MASS) * CELL_MAX_RADIUS;
+    store.radius[index] = (mass / CELL_MAX_MASS) * CELL_MAX_RADIUS;
+}
 
-    m_shape.setRadius(m_radius);
-    m_shape.setOrigin(m_radius, m_radius);
+void Cell::splitCell(World& world, u32 cell, const float dt, CommandBuffer& buffer)
+{
+    EntityStore& store = world.getStore();
+    CellComponents& cells = store.cells;
 
-    Entity::update(dt);
+    const u32 index = cells.entity[cell];
 
-    // Recalculate the directional line.
-    caculateDebugLines();
+    cells.splitTimer[cell] += dt;
 
-    calculateRoundBar(m_foodBar, sf::Color::Green, m_foodAmount, 2.0f);
+    const r32 timePassed = cells.splitTimer[cell];
 
-    splitCell();
-}
+    if (timePassed >= cells.dna[cell].traits.splitRate || (cells.foodAmount[cell] >= 10.0f && timePassed >= 10.0f)) {
 
-void Cell::splitCell()
-{
-    const r32 timePassed = m_cellSplitClock.getElapsedTime().asSeconds();
+        RandomGen random(world.getSeed(), store.id[index], world.getTick(), RandomPurpose::Split);
 
-    if (timePassed >= m_splitRate || (m_foodAmount >= 10.0f && timePassed >= 10.0f)) {
+        const r32 randomRad = random.randomFloat(0.0f, 2.0f * Pi);
 
-        const r32 pi2 = Pi * 2.0f;
-        const r32 randomRad = RandomGen::randomFloat(0.0f, 2.0f * Pi);
+        const vec2f location = store.location[index];
 
         // Add some padding so the new cell doesn't get stuck to us.
-        const r32 diameter = (m_radius * 2.0f) + 10.0f;
+        const r32 diameter = (store.radius[index] * 2.0f) + 10.0f;
 
         int tries = 0;
         vec2f newLocation;
         do
         {
-            newLocation = m_location + vec2f(std::cos(randomRad) * diameter,
-                                             std::sin(randomRad) * diameter);
+            newLocation = location + vec2f(std::cos(randomRad) * diameter,
+                                           std::sin(randomRad) * diameter);
             tries++;
 
             if (tries > 9) {
-                newLocation = m_world.randomWorldPoint();
+                newLocation = world.randomWorldPoint(random);
             }
         }
-        while(!m_world.isPointInWorld(newLocation) && tries < 10);
+        while(!world.isPointInWorld(newLocation) && tries < 10);
 
-        // TODO: Check the breeder and how it is moving/copying genomes.
+        const r32 halfMass = store.mass[index] * 0.5f;
 
-        Cell* baby = new Cell(m_generation + 1, Breeder::replicate(m_dna), newLocation, m_world);
+        BirthCommand birth = {
+            cells.generation[cell] + 1,
+            store.id[index],
+            Breeder::replicate(cells.dna[cell], random),
+            newLocation,
+            // Launch the baby cell away so it has a better chance.
+            -(store.velocity[index]),
+            halfMass
+        };
 
-        const r32 halfMass = m_mass * 0.5f;
+        buffer.births.push_back(std::move(birth));
 
-        baby->m_mass = halfMass;
-        m_mass = halfMass;
+        store.mass[index] = halfMass;
 
         // Take some energy since we just divided.
-        m_foodAmount -= 25.0f;
-
-        // Launch the baby cell away so it has a better chance.
-        baby->m_velocity = -(m_velocity);
-
-        m_world.add(baby);
-
-        m_cellSplitClock.restart();
+        cells.foodAmount[cell] -= 25.0f;
+        cells.splitTimer[cell] = 0.0f;
     }
 }
 
-void Cell::calculateClosestCell(std::vector<Entity*> list, r32& distance, r32& direction, r32 radius)
+void Cell::calculateVisionLines(const EntityStore& store, u32 cell, const vec2f& location, VisionLines& visionLines)
 {
-    Entity* found = 0;
-    r32 distSq = std::numeric_limits<r32>::max();
-
-    for (auto& entity : list) {
-
-        if (entity->getType() == EntityType::Cell)
-            if (vec2f::distanceSquared(entity->getLocation(), m_location) <= distSq)
-                found = entity;
-    }
+    const u32 index = store.cells.entity[cell];
 
-    if (found == 0) {
-        distance = 0;
-        direction = 0;
-        radius = 0;
-        return;
-    }
-    else {
-        distance = vec2f::distance(found->getLocation(), m_location);
-        direction = m_rotation - vec2f::direction(found->getLocation(), m_location);
-        radius = found->getRadius();
-    }
-}
+    const Traits& traits = store.cells.dna[cell].traits;
+    const r32 rotation = store.rotation[index];
 
-void Cell::calculateClosestResource(std::vector<Entity*> list, r32& distance, r32& direction, type::ResourceType resourceType)
-{
-    Entity* found = 0;
-    r32 distSq = std::numeric_limits<r32>::max();
+    const r32 rotationA = rotation - traits.eyeOffsetA;
+    const r32 rotationB = rotation + traits.eyeOffsetB;
 
-    for (auto& entity : list) {
+    // TODO: Remove the trig functions here.
 
-        if (entity->getType() == EntityType::Resource)
-            if (((Resource*)entity)->getResourceType() == resourceType)
-                if (vec2f::distanceSquared(entity->getLocation(), m_location) <= distSq)
-                    found = entity;
-    }
+    vec2f* lines = visionLines.points;
 
-    if (found == 0) {
-        distance = 0;
-        direction = 0;
-        return;
-    }
-    else {
-        distance = vec2f::distance(found->getLocation(), m_location);
-        direction = m_rotation - vec2f::direction(found->getLocation(), m_location);
-    }
+    lines[0] = location + vec2f(std::cos(rotation) * traits.eyeLengthA, std::sin(rotation) * traits.eyeLengthA);
+    lines[1] = location + vec2f(std::cos(rotationA) * traits.eyeLengthB, std::sin(rotationA) * traits.eyeLengthB);
+    lines[2] = location + vec2f(std::cos(rotationB) * traits.eyeLengthC, std::sin(rotationB) * traits.eyeLengthC);
 }
 
-void Cell::caculateVisionLines()
+void Cell::calculateVision(World& world, u32 cell, const VisionLines& visionLines, r32* outputs)
 {
-    const r32 rotationA = m_rotation - m_dna.traits.eyeOffsetA;
-    const r32 rotationB = m_rotation + m_dna.traits.eyeOffsetB;
-
-    // TODO: Remove the trig functions here.
+    const EntityStore& store = world.getStore();
+    const u32 index = store.cells.entity[cell];
 
-    m_visionLines[0] = m_location + vec2f(std::cos(m_rotation) * m_dna.traits.eyeLengthA, std::sin(m_rotation) * m_dna.traits.eyeLengthA);
-    m_visionLines[1] = m_location + vec2f(std::cos(rotationA) * m_dna.traits.eyeLengthB, std::sin(rotationA) * m_dna.traits.eyeLengthB);
-    m_visionLines[2] = m_location + vec2f(std::cos(rotationB) * m_dna.traits.eyeLengthC, std::sin(rotationB) * m_dna.traits.eyeLengthC);
-}
+    const vec2f location = store.location[index];
+    const vec2f* lines = visionLines.points;
 
-void Cell::calculateVision(std::vector<Entity*> list, r32* outputs)
-{
     VisionResult results[3];
 
-    for (auto& entity : list) {
+    // Check the vision lines against all of the entities in the nearby grid cells.
+    world.forEachNear(index, true, [&](u32 entity) {
+
+        const vec2f entityLocation = store.location[entity];
+        const r32 entityRadius = store.radius[entity];
 
         r32 distA = 0;
         r32 distB = 0;
         r32 distC = 0;
 
         bool intersectA =
-                circleLineIntersect(m_location, m_visionLines[0], entity->getLocation(), entity->getRadius(), &distA);
+                circleLineIntersect(location, lines[0], entityLocation, entityRadius, &distA);
 
         bool intersectB =
-                circleLineIntersect(m_location, m_visionLines[1], entity->getLocation(), entity->getRadius(), &distB);
+                circleLineIntersect(location, lines[1], entityLocation, entityRadius, &distB);
 
         bool intersectC =
-                circleLineIntersect(m_location, m_visionLines[2], entity->getLocation(), entity->getRadius(), &distC);
+                circleLineIntersect(location, lines[2], entityLocation, entityRadius, &distC);
 
         if (intersectA) {
-            results[0].color = entity->getColor();
+            results[0].color = store.color[entity];
             results[0].distance = distA;
         }
 
         if (intersectB) {
-            results[1].color = entity->getColor();
+            results[1].color = store.color[entity];
             results[1].distance = distB;
         }
 
         if (intersectC) {
-            results[2].color = entity->getColor();
+            results[2].color = store.color[entity];
             results[2].distance = distC;
         }
-    }
+    });
 
-    for (u32 offset = 0, i = 0; i < 4; i++, offset += 4) {
+    for (u32 offset = 0, i = 0; i < 3; i++, offset += 4) {
         outputs[offset] = results[i].distance;
         outputs[offset+1] = results[i].color.x;
         outputs[offset+2] = results[i].color.y;
@@ -305,57 +254,18 @@ void Cell::calculateVision(std::vector<Entity*> list, r32* outputs)
     }
 }
 
-void Cell::caculateDebugLines()
+void Cell::onCollision(World& world, u32 cell, u32 other)
 {
-    m_debugLines.clear();
-
-    r32 length = (m_velocity.length() / 500.0f) + 8.0f;
-    vec2f newPoint = (length) * vec2f::normalizeOrZero(m_velocity);
+    EntityStore& store = world.getStore();
+    CellComponents& cells = store.cells;
 
-    sf::Vector2f pointA(m_location.x, m_location.y);
-    sf::Vector2f pointB(newPoint.x, newPoint.y);
-
-    m_debugLines.append(sf::Vertex(pointA, sf::Color::Red));
-    m_debugLines.append(sf::Vertex(pointA + pointB, sf::Color::Red));
-
-    m_debugLines.append(sf::Vertex(pointA, sf::Color::Cyan));
-    m_debugLines.append(sf::Vertex(sf::Vector2f(m_visionLines[0].x, m_visionLines[0].y), sf::Color::Cyan));
-
-    m_debugLines.append(sf::Vertex(pointA, sf::Color::Green));
-    m_debugLines.append(sf::Vertex(sf::Vector2f(m_visionLines[1].x, m_visionLines[1].y), sf::Color::Green));
-
-    m_debugLines.append(sf::Vertex(pointA, sf::Color::Blue));
-    m_debugLines.append(sf::Vertex(sf::Vector2f(m_visionLines[2].x, m_visionLines[2].y), sf::Color::Blue));
-}
-
-void Cell::calculateRoundBar(sf::VertexArray& vertexArray, const sf::Color color, const r32 value, const r32 offset)
-{
-    vertexArray.clear();
-
-    const r32 pi2 = Pi * 2.0f;
-    const r32 step = pi2 / 16.0f;
-
-    const r32 stopAt = clamp((value / CELL_MAX_FOOD) * pi2, 0.0f, pi2);
-
-    for (r32 radians = 0; radians <= stopAt; radians += step) {
-
-        vec2f point = vec2f(std::cos(radians) * (m_radius + offset),
-                            std::sin(radians) * (m_radius + offset));
-
-        vertexArray.append(sf::Vertex(
-                             sf::Vector2f((point.x + m_location.x) ,
-                                          (point.y + m_location.y)), color));
-    }
-}
-
-void Cell::onCollision(Entity* other)
-{
-    EntityType otherType = other->getType();
+    const u32 index = cells.entity[cell];
+    const EntityType otherType = store.type[other];
 
     // Do cell to cell collision.
     if (otherType == EntityType::Cell) {
 
-        Cell* ocell = (Cell*)other;
+        const u32 otherCell = store.component[other];
 
         // so splitting wouldn't actually make their food level = half because of their new mass
         // Divide the incoming food by the mass of the cell then add it to the food value
@@ -363,37 +273,35 @@ void Cell::onCollision(Entity* other)
         // TODO: add more size ranges on the food
 
         // We are bigger than them.
-        if (ocell->m_mass < m_mass) {
+        if (store.mass[other] < store.mass[index]) {
 
-            ocell->m_foodAmount -= 8.0f;
-            m_foodAmount += 4.0f;
-            m_mass += 4.0f;
+            cells.foodAmount[otherCell] -= 8.0f;
+            cells.foodAmount[cell] += 4.0f;
+            store.mass[index] += 4.0f;
         }
         // They are bigger than us
         else {
 
-            ocell->m_foodAmount += 8.0f;
-            m_foodAmount -= 4.0f;
-            m_mass -= 4.0f;
+            cells.foodAmount[otherCell] += 8.0f;
+            cells.foodAmount[cell] -= 4.0f;
+            store.mass[index] -= 4.0f;
         }
     }
     // Do cell to resource collision.
     else if (otherType == EntityType::Resource) {
 
-        Resource* resource = (Resource*)other;
-        if (resource->getResourceType() == type::Food) {
-            m_foodAmount += resource->consume(8.0f);
-            m_mass += 4.0f;
+        const u32 resource = store.component[other];
+        const type::ResourceType resourceType = store.resources.resourceType[resource];
+
+        if (resourceType == type::Food) {
+            const r32 eaten = Resource::consume(store, resource, 8.0f);
+            world.getEvents().consume(world.getTick(), store.id[index], store.id[other], resourceType, eaten);
+
+            cells.foodAmount[cell] += eaten;
+            store.mass[index] += 4.0f;
         }
-        else if (resource->getResourceType() == type::Fire)
-            m_foodAmount -= 10.0f;
+        else if (resourceType == type::Fire)
+            cells.foodAmount[cell] -= 10.0f;
 
     }
 }
-
-void Cell::render(sf::RenderTarget& target)
-{
-    Entity::render(target);
-    target.draw(m_debugLines, Content::shader);
-    target.draw(m_foodBar, Content::shader);
-}
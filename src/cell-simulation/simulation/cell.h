@@ -1,152 +1,114 @@
 #ifndef CELL_H_INCLUDE
 #define CELL_H_INCLUDE
 
+// Standard includes.
+#include <vector>
+
 // SCL includes.
 #include <scl/math/vec2.h>
 #include <scl/math/vec3.h>
 
-// SFML includes.
-#include <SFML/System/Clock.hpp>
-
 // Project includes.
 #include "entity.h"
+#include "eventstream.h"
 #include "genetics/dna.h"
-#include "resource.h"
+
+const r32 CELL_MAX_MASS = 100.0f;
+const r32 CELL_MAX_FOOD = 100.0f;
+const r32 CELL_MAX_RADIUS = 30.0f;
+
+/**
+ * @brief The topology of the network shared by every cell.
+ */
+const u32 CELL_NETWORK_INPUTS = 19;
+const u32 CELL_NETWORK_HIDDEN = 16;
+const u32 CELL_NETWORK_OUTPUTS = 4;
 
 /**
- * @brief This class represents a cell in the simulation world.
+ * @brief The end points of the three vision lines of a cell.
  */
-class Cell : public Entity {
+struct VisionLines
+{
+    vec2f points[3];
+};
+
+/**
+ * @brief This class contains the behaviour of the cells in the simulation world.
+ */
+class Cell {
 public:
 
     /**
-     * @brief The default cell constructor.
+     * @brief Create a new cell in the world.
+     * @param world = The world to place the cell in.
+     * @param generation = The generation of the cell.
      * @param dna = The dna data for the cell.
      * @param location = The location of the cell.
-     * @param world = The world to place the cell in.
-     */
-    Cell(i32 generation, DNA dna, vec2f location, World& world);
-
-    ~Cell();
-
-    /**
-     * @brief Occurs when the cell entity is update.
-     * @param dt = Delta time.
-     */
-    void update(const float dt);
-
-    /**
-     * @brief Occurs when the cell entity is rendered.
-     * @param target = The target to render to.
+     * @param parent = The unique id of the cell it split from, NO_ENTITY if it didn't.
+     * @return The dense entity index of the new cell.
      */
-    void render(sf::RenderTarget& target);
+    static u32 create(World& world, i32 generation, DNA dna, vec2f location, u32 parent = NO_ENTITY);
 
     /**
-     * @brief The number of active cells in the world.
+     * @brief Sense the surroundings of a cell and fill in its network inputs.
+     * @param world = The world the cell exists in.
+     * @param cell = The cell component index.
+     * @param inputs = The CELL_NETWORK_INPUTS input values to fill in.
      */
-    static i32 m_cellCount;
+    static void sense(World& world, u32 cell, r32* inputs);
 
     /**
-     * @brief Get the generation number of this cell.
-     * @return The generation of the cell.
-     */
-    i32 getGeneration() const { return m_generation; }
-
-    DNA getDna() const { return m_dna; }
-
-private:
-
-    /**
-     * @brief The current generation of the cell.
+     * @brief Steer a cell using its network outputs and update its food and size.
+     * @param world = The world the cell exists in.
+     * @param cell = The cell component index.
+     * @param outputs = The CELL_NETWORK_OUTPUTS output values computed for the cell.
+     * @param dt = Delta time.
      */
-    i32 m_generation;
+    static void update(World& world, u32 cell, const r32* outputs, const float dt);
 
     /**
-     * @brief The amount of food that the cell currently has.
+     * @brief Occurs when a cell collides with another entity.
+     * @param world = The world the cell exists in.
+     * @param cell = The cell component index.
+     * @param other = The dense index of the entity that we collided with.
      */
-    r32 m_foodAmount;
+    static void onCollision(World& world, u32 cell, u32 other);
 
     /**
-     * @brief The time in seconds in at which the cell splits.
+     * @brief Calculates when to split the cell and records the new cell.
+     * The parent is updated straight away, the new cell is added when the births are applied.
+     * @param world = The world the cell exists in.
+     * @param cell = The cell component index.
+     * @param dt = Delta time.
+     * @param buffer = The command buffer to record the birth into.
      */
-    r32 m_splitRate;
+    static void splitCell(World& world, u32 cell, const float dt, CommandBuffer& buffer);
 
     /**
-     * @brief The time used to provide a constant source of input.
+     * @brief Calculate the vision line end points of a cell.
+     * The lines are only kept while they are needed, by the sense phase and by the renderer.
+     * @param store = The store the cell exists in.
+     * @param cell = The cell component index.
+     * @param location = The location to start the lines from.
+     * @param lines = The end points to fill in.
      */
-    r32 time = 0.0f;
+    static void calculateVisionLines(const EntityStore& store, u32 cell, const vec2f& location, VisionLines& lines);
 
-    /**
-     * @brief The dna data for this cell.
-     */
-    DNA m_dna;
+private:
 
     struct VisionResult {
         r32 distance = 0.f;
         vec3f color = {0.f, 0.f, 0.f};
     };
 
-    vec2f m_visionLines[6];
-
-    r32 m_memory[2] = {0.f, 0.f};
-
-    /**
-     * @brief Used to draw the direction line of the cell.
-     */
-    sf::VertexArray m_debugLines;
-
-    /**
-     * @brief Used to draw the food health bar.
-     */
-    sf::VertexArray m_foodBar;
-
-    /**
-     * @brief The clock used to track the cell splitting processes.
-     */
-    sf::Clock m_cellSplitClock;
-
-    /**
-     * @brief Calculate the vertex data used to render the round info bar.
-     */
-    void calculateRoundBar(sf::VertexArray& vertexArray, const sf::Color color, const r32 value, const r32 offset);
-
-    /**
-     * @brief Occurs when we collide with another entity.
-     * @param other = The entity that we collided with.
-     */
-    void onCollision(Entity *other);
-
-    /**
-     * @brief Caculate the closest cell entity and the associated values.
-     * @param list = The entity list to use.
-     * @param distance = The distance to the cell entity.
-     * @param direction = The direction to the cell entity.
-     */
-    void calculateClosestCell(std::vector<Entity*> list, r32& distance, r32& direction, r32 radius);
-
-    /**
-     * @brief Calculate the closest resource entity and the associated values.
-     * @param list = The entity list to use.
-     * @param distance = The distance to the resource entity.
-     * @param direction = The direction toe the resource entity.
-     * @param resourceType = The type of resource to look for.
-     */
-    void calculateClosestResource(std::vector<Entity*> list, r32& distance, r32& direction, type::ResourceType resourceType);
-
-    void calculateVision(std::vector<Entity*> list, r32* outputs);
-
-    /**
-     * @brief Calculate the verteices for the direction line.
-     */
-    void caculateDebugLines();
-
-    void caculateVisionLines();
-
-    //Entity* lineToEntityCollision(vec2f lineA, vec2f lineB, vec)
     /**
-     * @brief Called in the update method. Calculates when to split the cell.
+     * @brief Calculate what the vision lines of the cell can see.
+     * @param world = The world the cell exists in.
+     * @param cell = The cell component index.
+     * @param lines = The vision lines of the cell.
+     * @param outputs = The twelve vision values, distance and color for each line.
      */
-    void splitCell();
+    static void calculateVision(World& world, u32 cell, const VisionLines& lines, r32* outputs);
 };
 
 #endif // CELL_H_INCLUDE
@@ -0,0 +1,223 @@
+#include "checkpointer.h"
+
+// Standard includes.
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+// Project includes.
+#include "world.h"
+#include "snapshot.h"
+
+#include <util/binarystream.h>
+#include <util/log.h>
+
+typedef std::chrono::steady_clock Clock;
+
+Checkpointer::Checkpointer() :
+    m_interval(0),
+    m_retention(3),
+    m_checkpointCount(0),
+    m_pending(false),
+    m_running(false),
+    m_writtenCount(0),
+    m_skippedCount(0),
+    m_captureTime(0.0),
+    m_latency(0.0)
+{ }
+
+Checkpointer::~Checkpointer()
+{
+    if (m_thread.joinable()) {
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_running = false;
+        }
+
+        // The writer finishes the pending checkpoint before it stops.
+        m_condition.notify_all();
+        m_thread.join();
+    }
+}
+
+void Checkpointer::update(const World& world)
+{
+    if (m_interval == 0 || world.getTick() % m_interval != 0)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Never wait on the disk, drop this checkpoint and catch the next one.
+        if (m_pending) {
+            m_skippedCount++;
+            return;
+        }
+    }
+
+    const Clock::time_point start = Clock::now();
+
+    Snapshot::capture(world, m_captureBuffer);
+
+    const Clock::time_point end = Clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        std::swap(m_captureBuffer, m_writeBuffer);
+
+        m_writePath = getSlotPath(m_checkpointCount % m_retention);
+        m_pending = true;
+        m_pendingStart = start;
+        m_captureTime = std::chrono::duration<r64>(end - start).count();
+    }
+
+    m_checkpointCount++;
+
+    if (!m_thread.joinable()) {
+        m_running = true;
+        m_thread = std::thread(&Checkpointer::run, this);
+    }
+    else {
+        m_condition.notify_all();
+    }
+}
+
+void Checkpointer::flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this] { return !m_pending; });
+}
+
+void Checkpointer::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true) {
+
+        m_condition.wait(lock, [this] { return m_pending || !m_running; });
+
+        if (!m_pending)
+            break;
+
+        const std::string path = m_writePath;
+
+        // The simulation thread leaves the write buffer alone while the checkpoint is pending.
+        lock.unlock();
+
+        const bool written = writeFileAtomic(path, m_writeBuffer.data(), m_writeBuffer.size());
+
+        lock.lock();
+
+        if (written) {
+            m_writtenCount++;
+            m_latency = std::chrono::duration<r64>(Clock::now() - m_pendingStart).count();
+        }
+        else {
+            Log::error("failed to write checkpoint: " + path);
+        }
+
+        m_pending = false;
+        m_condition.notify_all();
+    }
+}
+
+void Checkpointer::removeStale()
+{
+    flush();
+
+    // The slots are filled in order so stop at the first one that is missing.
+    for (u32 slot = m_retention; ; slot++) {
+
+        const std::string path = getSlotPath(slot);
+
+        if (std::remove(path.c_str()) != 0)
+            break;
+    }
+}
+
+bool Checkpointer::findLatest(const std::string& snapshotPath, std::string& filePath)
+{
+    std::vector<std::string> paths;
+    paths.push_back(snapshotPath);
+
+    // The slots are filled in order so stop at the first one that is missing.
+    for (u32 slot = 0; ; slot++) {
+
+        const std::string path = getSlotPath(slot);
+
+        std::ifstream file(path.c_str(), std::ios::in | std::ios::binary);
+        if (!file.is_open())
+            break;
+
+        paths.push_back(path);
+    }
+
+    std::vector<SnapshotInfo> infos(paths.size());
+    std::vector<bool> valid(paths.size());
+
+    // Pick the run that was started last, then its newest file.
+    bool found = false;
+    SnapshotInfo latest;
+
+    for (u32 i = 0; i < paths.size(); i++) {
+
+        valid[i] = Snapshot::readInfo(paths[i], infos[i]);
+        if (!valid[i])
+            continue;
+
+        if (!found || infos[i].runStartTime > latest.runStartTime) {
+            latest = infos[i];
+            found = true;
+        }
+    }
+
+    if (!found)
+        return false;
+
+    for (u32 i = 0; i < paths.size(); i++) {
+
+        if (!valid[i] || !infos[i].isSameRun(latest))
+            continue;
+
+        if (infos[i].tick >= latest.tick) {
+            latest = infos[i];
+            filePath = paths[i];
+        }
+    }
+
+    return true;
+}
+
+u64 Checkpointer::getWrittenCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_writtenCount;
+}
+
+u64 Checkpointer::getSkippedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_skippedCount;
+}
+
+r64 Checkpointer::getCaptureTime() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_captureTime;
+}
+
+r64 Checkpointer::getLatency() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_latency;
+}
+
+std::string Checkpointer::getSlotPath(u32 slot)
+{
+    std::stringstream sb;
+    sb << CHECKPOINT_FILE_PATH << "." << slot << ".bin";
+    return sb.str();
+}
@@ -0,0 +1,218 @@
+#ifndef CHECKPOINTER_H_INCLUDE
+#define CHECKPOINTER_H_INCLUDE
+
+// Standard includes.
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <scl/types.h>
+
+class World;
+
+/**
+ * @brief The path checkpoints are written to, the slot number and extension are added to it.
+ */
+const std::string CHECKPOINT_FILE_PATH = "../../data/checkpoint";
+
+/**
+ * @brief Takes periodic snapshots of a world and writes them to disk on a background thread.
+ *
+ * The world is captured into a buffer at the tick boundary, which is only a copy of the store
+ * arrays, and the buffer is handed to the writer thread. The two buffers are swapped rather
+ * than copied so once they have grown no more memory is allocated. If the writer is still busy
+ * with the last checkpoint when the next one is due, that checkpoint is skipped rather than
+ * making the simulation wait on the disk.
+ *
+ * The checkpoints rotate through a fixed number of files so only the newest few are kept.
+ * Each file names the run it was taken of, so the files of different runs are never mixed up.
+ */
+class Checkpointer
+{
+public:
+
+    /**
+     * @brief Create a checkpointer with checkpoints turned off.
+     */
+    Checkpointer();
+
+    /**
+     * @brief Wait for the last checkpoint to be written and stop the writer thread.
+     */
+    ~Checkpointer();
+
+    Checkpointer(const Checkpointer&) = delete;
+    Checkpointer& operator=(const Checkpointer&) = delete;
+
+    /**
+     * @brief Set how often a checkpoint is taken.
+     * @param interval = The number of ticks between checkpoints, (0 for off)
+     */
+    void setInterval(u64 interval) { m_interval = interval; }
+
+    /**
+     * @brief Get how often a checkpoint is taken.
+     * @return The number of ticks between checkpoints, 0 when off.
+     */
+    u64 getInterval() const { return m_interval; }
+
+    /**
+     * @brief Set the number of checkpoint files to rotate through.
+     * @param retention = The number of checkpoints to keep, at least one.
+     */
+    void setRetention(u32 retention) { m_retention = (retention > 0) ? retention : 1; }
+
+    /**
+     * @brief Get the number of checkpoint files rotated through.
+     * @return The number of checkpoints kept.
+     */
+    u32 getRetention() const { return m_retention; }
+
+    /**
+     * @brief Take a checkpoint if one is due, called at the end of each tick.
+     * @param world = The world to capture.
+     */
+    void update(const World& world);
+
+    /**
+     * @brief Wait for the checkpoint being written to reach the disk.
+     */
+    void flush();
+
+    /**
+     * @brief Delete the checkpoint files past the retention, left by a run that kept more of them.
+     */
+    void removeStale();
+
+    /**
+     * @brief Find the newest snapshot or checkpoint of the run that was started last.
+     * Only the files of that run are compared by tick, so a longer older run can never take over.
+     * @param snapshotPath = The snapshot saved on exit, it is checked along with the checkpoints.
+     * @param filePath = Set to the path of the newest file.
+     * @return True if any valid file was found.
+     */
+    static bool findLatest(const std::string& snapshotPath, std::string& filePath);
+
+    /**
+     * @brief Get the number of checkpoints written to disk.
+     * @return The written checkpoint count.
+     */
+    u64 getWrittenCount() const;
+
+    /**
+     * @brief Get the number of checkpoints skipped because the writer was still busy.
+     * @return The skipped checkpoint count.
+     */
+    u64 getSkippedCount() const;
+
+    /**
+     * @brief Get how long the simulation was stopped for to capture the last checkpoint.
+     * @return The capture time in seconds.
+     */
+    r64 getCaptureTime() const;
+
+    /**
+     * @brief Get the time from the capture of the last written checkpoint to it reaching the disk.
+     * @return The checkpoint latency in seconds.
+     */
+    r64 getLatency() const;
+
+private:
+
+    /**
+     * @brief The number of ticks between checkpoints, 0 when off.
+     */
+    u64 m_interval;
+
+    /**
+     * @brief The number of checkpoint files to rotate through.
+     */
+    u32 m_retention;
+
+    /**
+     * @brief The number of checkpoints handed to the writer, picks the next file to write.
+     */
+    u64 m_checkpointCount;
+
+    /**
+     * @brief The buffer the world is captured into, only touched by the simulation thread.
+     */
+    std::vector<char> m_captureBuffer;
+
+    /**
+     * @brief The buffer being written, only touched by the writer while a write is pending.
+     */
+    std::vector<char> m_writeBuffer;
+
+    /**
+     * @brief The path the pending buffer is written to.
+     */
+    std::string m_writePath;
+
+    /**
+     * @brief Set when the write buffer holds a checkpoint that hasn't reached the disk yet.
+     */
+    bool m_pending;
+
+    /**
+     * @brief Cleared to stop the writer thread.
+     */
+    bool m_running;
+
+    /**
+     * @brief The number of checkpoints written to disk.
+     */
+    u64 m_writtenCount;
+
+    /**
+     * @brief The number of checkpoints skipped while the writer was busy.
+     */
+    u64 m_skippedCount;
+
+    /**
+     * @brief How long the last capture took in seconds.
+     */
+    r64 m_captureTime;
+
+    /**
+     * @brief The capture to disk time of the last written checkpoint in seconds.
+     */
+    r64 m_latency;
+
+    /**
+     * @brief The time the pending checkpoint was captured, used for the latency.
+     */
+    std::chrono::steady_clock::time_point m_pendingStart;
+
+    /**
+     * @brief Guards the pending state, the paths and the stats.
+     */
+    mutable std::mutex m_mutex;
+
+    /**
+     * @brief Wakes the writer when a checkpoint is pending and the simulation when it is written.
+     */
+    std::condition_variable m_condition;
+
+    /**
+     * @brief The writer thread, started with the first checkpoint.
+     */
+    std::thread m_thread;
+
+    /**
+     * @brief The writer thread loop.
+     */
+    void run();
+
+    /**
+     * @brief Get the path of a checkpoint slot.
+     * @param slot = The slot number.
+     * @return The file path.
+     */
+    static std::string getSlotPath(u32 slot);
+};
+
+#endif // CHECKPOINTER_H_INCLUDE
@@ -0,0 +1,125 @@
+#ifndef COMMANDBUFFER_H_INCLUDE
+#define COMMANDBUFFER_H_INCLUDE
+
+// Standard includes.
+#include <vector>
+
+#include <scl/types.h>
+#include <scl/math/vec2.h>
+
+// Project includes.
+#include "entity.h"
+#include "resource.h"
+#include "genetics/dna.h"
+
+/**
+ * @brief Two entities that were found touching during the collide phase.
+ */
+struct CollisionCommand
+{
+    /**
+     * @brief The dense index of the entity that found the collision, the lower index of a pair of live entities.
+     */
+    u32 entity;
+
+    /**
+     * @brief The dense index of the entity it collided with.
+     */
+    u32 other;
+
+    bool operator<(const CollisionCommand& rhs) const
+    {
+        return entity < rhs.entity || (entity == rhs.entity && other < rhs.other);
+    }
+};
+
+/**
+ * @brief A cell born from a split, added to the world once the dead entities are removed.
+ */
+struct BirthCommand
+{
+    /**
+     * @brief The generation of the new cell.
+     */
+    i32 generation;
+
+    /**
+     * @brief The unique id of the cell it split from.
+     */
+    u32 parent;
+
+    /**
+     * @brief The dna of the new cell.
+     */
+    DNA dna;
+
+    /**
+     * @brief The location of the new cell.
+     */
+    vec2f location;
+
+    /**
+     * @brief The velocity of the new cell.
+     */
+    vec2f velocity;
+
+    /**
+     * @brief The mass of the new cell.
+     */
+    r32 mass;
+};
+
+/**
+ * @brief An entity that died and is to be replaced with a new one.
+ */
+struct RespawnCommand
+{
+    /**
+     * @brief The unique id of the entity that died, keys the random stream of the replacement.
+     */
+    u32 id;
+
+    /**
+     * @brief The type of entity to create.
+     */
+    EntityType type;
+
+    /**
+     * @brief The type of resource to create when the entity is a resource.
+     */
+    type::ResourceType resourceType;
+};
+
+/**
+ * @brief The writes a worker can't make directly during a parallel phase.
+ * Each worker records into its own buffer and the world applies them once the phase is done.
+ */
+struct CommandBuffer
+{
+    /**
+     * @brief The collisions to resolve.
+     */
+    std::vector<CollisionCommand> collisions;
+
+    /**
+     * @brief The cells born this tick.
+     */
+    std::vector<BirthCommand> births;
+
+    /**
+     * @brief The entities to replace this tick.
+     */
+    std::vector<RespawnCommand> respawns;
+
+    /**
+     * @brief Remove the recorded commands, the memory is kept for the next tick.
+     */
+    void clear()
+    {
+        collisions.clear();
+        births.clear();
+        respawns.clear();
+    }
+};
+
+#endif // COMMANDBUFFER_H_INCLUDE
@@ -1,83 +1,82 @@
 #include "entity.h"
-#include "../core/content.h"
+#include "entitystore.h"
 #include "world.h"
-#include "partitioning/hashnode.h"
-#include "partitioning/hashutils.h"
+#include "cell.h"
+#include "commandbuffer.h"
 
 #include <scl/math/circle.h>
 #include <iostream>
 
-// Start the global id counter at zero.
-u32 Entity::m_globalIdCounter = 0;
-
-Entity::Entity(vec2f location, World& world, EntityType type) :
-    m_id(m_globalIdCounter++),
-    m_type(type),
-    m_alive(true),
-    m_hashUpdate(true),
-    m_radius(16.0f),
-    m_rotation(0.0f),
-    m_mass(1.0f),
-    m_location(location),
-    m_lastNode(-10000, -10000),
-    m_velocity(vec2f()),
-    m_friction(vec2f(1.0f)),
-    m_world(world),
-    m_currentNode(0),
-    m_color(0.f)
-{ }
-
-Entity::~Entity()
-{ }
-
-void Entity::update(const float dt)
+void Entity::integrate(World& world, u32 index, const float dt)
 {
+    EntityStore& store = world.getStore();
+
+    // Remember where we were so the renderer can blend between the two steps.
+    store.previousLocation[index] = store.location[index];
+
     // Add the velocity to the location of the entity.
-    m_location += m_velocity * dt;
+    store.location[index] += store.velocity[index] * dt;
 
     // Apply the friction to our velocity.
-    m_velocity *= m_friction;
+    store.velocity[index] *= store.friction[index];
 
-    // Update the position of our shape.
-    m_shape.setPosition(m_location.x, m_location.y);
+    const vec2f worldCenter = vec2f();
+    const r32 radius = store.radius[index];
 
-    // Only handle the collison once per entity pair.
-    std::vector<Entity*> collisionList = getNearEntities(false);
+    if (!Circle<r32>::intersects(
+             worldCenter, world.getRadius() - radius * 2.0f,
+             store.location[index], radius)) {
 
-    for (auto& entity : collisionList) {
+        vec2f& velocity = store.velocity[index];
+        vec2f normal = vec2f::normalizeOrZero(worldCenter - store.location[index]);
 
-        if (Circle<r32>::intersects(
-                    entity->m_location, entity->m_radius,
-                    m_location, m_radius)) {
+        velocity = velocity - (normal * 2.0f * vec2f::dot(normal, velocity));
 
-            handleCollision(entity, this);
-            onCollision(entity);
-        }
+        // v=v-normal*2*dot(normal, v)
+        //where normal is the map edge normal (direction from hit point to map origin)
+
+        //TODO (Tyler): Figure out a better method for applying this offset.
 
+        store.location[index] += (velocity * dt) * 2.0f;
     }
+}
 
-    const vec2f worldCenter = vec2f();
+void Entity::findCollisions(const World& world, u32 index, CommandBuffer& buffer)
+{
+    const EntityStore& store = world.getStore();
 
-    if (!Circle<r32>::intersects(
-             worldCenter, m_world.getRadius() - m_radius * 2.0f,
-             m_location, m_radius)) {
+    world.forEachNear(index, false, [&](u32 other) {
 
-        vec2f normal = vec2f::normalizeOrZero(worldCenter - m_location);
+        // Only record each pair once, from the lower index. A dead entity doesn't look for
+        // collisions itself so the pair has to be recorded from this side instead.
+        if (other < index && store.alive[other])
+            return;
 
-        m_velocity = m_velocity - (normal * 2.0f * vec2f::dot(normal, m_velocity));
+        if (Circle<r32>::intersects(
+                    store.location[other], store.radius[other],
+                    store.location[index], store.radius[index])) {
 
-        // v=v-normal*2*dot(normal, v)
-        //where normal is the map edge normal (direction from hit point to map origin)
+            CollisionCommand command;
+            command.entity = index;
+            command.other = other;
+            buffer.collisions.push_back(command);
+        }
+    });
+}
 
-        //TODO (Tyler): Figure out a better method for applying this offset.
+void Entity::collide(World& world, u32 index, u32 other)
+{
+    EntityStore& store = world.getStore();
 
-        m_location += (m_velocity * dt) * 2.0f;
-    }
+    handleCollision(store, other, index);
 
-    vec2i currentNode = calculateNode(m_location);
+    if (store.type[index] == EntityType::Cell) {
+        Cell::onCollision(world, store.component[index], other);
+    }
 
-    m_hashUpdate = (currentNode != m_lastNode);
-    m_lastNode = currentNode;
+    if (store.type[other] == EntityType::Cell && store.alive[other]) {
+        Cell::onCollision(world, store.component[other], index);
+    }
 }
 
 /*
@@ -86,46 +85,19 @@ void Entity::update(const float dt)
  *
  * v1 = (u1 * (m1 - m2) * (2 * m2 * u2)) / (m1 + m2)
  */
-void Entity::handleCollision(Entity* a, Entity* b)
+void Entity::handleCollision(EntityStore& store, u32 a, u32 b)
 {
-    vec2f u1 = a->m_velocity;
-    vec2f u2 = b->m_velocity;
+    vec2f u1 = store.velocity[a];
+    vec2f u2 = store.velocity[b];
 
-    if (vec2f::dot(u1 - u2, a->getLocation() - b->getLocation()) > 0.0f) {
+    if (vec2f::dot(u1 - u2, store.location[a] - store.location[b]) > 0.0f) {
         return;
     }
 
-    r32 m1 = a->m_mass;
-    r32 m2 = b->m_mass;
+    r32 m1 = store.mass[a];
+    r32 m2 = store.mass[b];
     r32 sum = m1 + m2;
 
-    a->m_velocity = (u1 * (m1 - m2) + (2.0f * m2 * u2)) / sum;
-    b->m_velocity = (u2 * (m2 - m1) + (2.0f * m1 * u1)) / sum;
-}
-
-void Entity::render(sf::RenderTarget& target)
-{
-    target.draw(m_shape, Content::shader);
-}
-
-//Also if you want to further optimize you can try pass the vector from outside,
-
-std::vector<Entity*> Entity::getNearEntities(bool fullSearch)
-{
-    std::vector<Entity*> closest;
-    closest.reserve(25);
-
-    if (fullSearch) {
-
-        for (auto& node : m_hashNodes) {
-            node->query(this, closest);
-        }
-    }
-    else {
-
-        if (m_currentNode)
-            m_currentNode->query(this, closest);
-    }
-
-    return closest;
+    store.velocity[a] = (u1 * (m1 - m2) + (2.0f * m2 * u2)) / sum;
+    store.velocity[b] = (u2 * (m2 - m1) + (2.0f * m1 * u1)) / sum;
 }
@@ -2,232 +2,97 @@
 #define ENTITY_H_INCLUDE
 
 // Standard includes.
-
-// SFML includes.
-#include <SFML/Graphics/RenderTarget.hpp>
-#include <SFML/Graphics/CircleShape.hpp>
+#include <vector>
 
 // SCL includes.
+#include <scl/types.h>
 #include <scl/math/vec2.h>
 #include <scl/math/vec3.h>
 
 class World;
-class HashNode;
+class EntityStore;
+struct CommandBuffer;
 
 /**
  * @brief Describes the type of entites.
  */
-enum class EntityType
+enum class EntityType : u8
 {
     Cell = 0,
     Resource = 1
 };
 
 /**
- * @brief The entity class does all of the based physics/collsion along with controlling the spatial hash.
+ * @brief Returned when an index can't be resolved.
  */
-class Entity
-{
-public:
-    friend class SpatialHash;
-    friend class HashNode;
-
-    /**
-     * @brief Construct an entity at the specified location.
-     * @param location = The location to place the entitiy.
-     * @param world = The world the entity exists in.
-     * @param type = The type of entity that is being created.
-     */
-    Entity(vec2f location, World& world, EntityType type);
-
-    /**
-     * @brief The default entity destructor.
-     */
-    virtual ~Entity();
-
-    /**
-     * @brief Update the entity.
-     * @param dt = The delta time.
-     */
-    virtual void update(const float dt);
-
-    /**
-     * @brief Render the entity.
-     * @param target = The target to render to.
-     */
-    virtual void render(sf::RenderTarget& target);
+const u32 INVALID_INDEX = 0xffffffff;
 
+/**
+ * @brief A stable reference to an entity, stays valid while the entity exists.
+ */
+struct EntityHandle
+{
     /**
-     * @brief Get the unique id of the entity.
-     * @return The unique id of the entity.
+     * @brief The slot the entity was given in the entity store.
      */
-    inline u32 getId() const { return m_id; }
+    u32 slot;
 
     /**
-     * @brief Get the type id of this entity.
-     * @return The type of entity.
+     * @brief The generation of the slot when the handle was created.
      */
-    inline EntityType getType() const { return m_type; }
+    u32 generation;
 
-    /**
-     * @brief Get the state of the entity.
-     * @return True if the entity is alive.
-     */
-    bool isAlive() const { return m_alive; }
+    EntityHandle() : slot(INVALID_INDEX), generation(0) { }
 
-    /**
-     * @brief Update the hash map for this entity.
-     * @return True if the entity needs a hash map update.
-     */
-    bool updateHash() const { return m_hashUpdate; }
+    EntityHandle(u32 slot, u32 generation) : slot(slot), generation(generation) { }
 
-    /**
-     * @brief Set the state of the entity.
-     * @param alive = The state of the entity.
-     */
-    void setAlive(bool alive) { m_alive = alive; }
+    bool operator==(const EntityHandle& other) const { return slot == other.slot && generation == other.generation; }
 
-    /**
-     * @brief Set the mass of the entity.
-     * @param mass = The mass to set.
-     */
-    void setMass(r32 mass) { m_mass = mass; }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
 
-    /**
-     * @brief Get the current radius of the entity.
-     * @return The radius of the entity.
-     */
-    inline r32 getRadius() const { return m_radius; }
+/**
+ * @brief The entity class does all of the based physics/collsion.
+ */
+class Entity
+{
+public:
 
     /**
-     * @brief Get the location of the entity.
-     * @return The current entity location.
+     * @brief Move an entity by its velocity and bounce it off the edge of the world.
+     * Only writes to the entity itself so it is safe to run in parallel.
+     * @param world = The world the entity exists in.
+     * @param index = The dense index of the entity.
+     * @param dt = The delta time.
      */
-    inline vec2f getLocation() const { return m_location; }
+    static void integrate(World& world, u32 index, const float dt);
 
     /**
-     * @brief Set the velocity of the entity.
-     * @param velocity = The velocity to set.
+     * @brief Find the entities touching an entity and record them in a command buffer.
+     * Each touching pair is only recorded once. Only reads from the world so it is safe to run in parallel.
+     * @param world = The world the entity exists in.
+     * @param index = The dense index of the entity.
+     * @param buffer = The command buffer of the worker.
      */
-    void setVelocity(vec2f velocity) { m_velocity = velocity; }
+    static void findCollisions(const World& world, u32 index, CommandBuffer& buffer);
 
     /**
-     * @brief Set the radius of the entity.
-     * @param radius = The new radius of the entity.
+     * @brief Resolve a collision recorded by findCollisions for both of the entities.
+     * @param world = The world the entities exist in.
+     * @param index = The dense index of the entity that found the collision.
+     * @param other = The dense index of the entity it collided with.
      */
-    void setRadius(r32 radius) { m_radius = radius; }
-
-    vec3f getColor() const { return m_color; }
+    static void collide(World& world, u32 index, u32 other);
 
 private:
 
-    /**
-     * @brief The global id counter, used to assign each entity a unique entity.
-     */
-    static u32 m_globalIdCounter;
-
-    /**
-     * @brief The unique id of the entity.
-     */
-    u32 m_id;
-
     /**
      * @brief Handle the collision between two entities.
-     * @param a = The first entity.
-     * @param b = The second entity.
-     */
-    void handleCollision(Entity* a, Entity* b);
-
-    /**
-     * @brief This method gets called when we collided with another entity, allows each entity to handle collisons as needed.
-     * @param other = The other entity that we collided with.
+     * @param store = The store the entities exist in.
+     * @param a = The dense index of the first entity.
+     * @param b = The dense index of the second entity.
      */
-    virtual void onCollision(Entity* other) { }
-
-protected:
-
-    /**
-     * @brief The type of entity that this is.
-     */
-    EntityType m_type;
-
-    /**
-     * @brief The state of the entity.
-     */
-    bool m_alive;
-
-    /**
-     * @brief Triggers the entity to be updated in the spatial hash.
-     */
-    bool m_hashUpdate;
-
-    /**
-     * @brief The radius of our center.
-     */
-    r32 m_radius;
-
-    /**
-     * @brief The current rotation of the entity.
-     */
-    r32 m_rotation;
-
-    /**
-     * @brief The mass of the entity used for collision response.
-     */
-    r32 m_mass;
-
-    /**
-     * @brief The location of the entity.
-     */
-    vec2f m_location;
-
-    /**
-     * @brief The last node the entity was in.
-     */
-    vec2i m_lastNode;
-
-    /**
-     * @brief The current velocity of the entity.
-     */
-    vec2f m_velocity;
-
-    /**
-     * @brief The friction of the entity.
-     */
-    vec2f m_friction;
-
-    /**
-     * @brief The color of the entity.
-     */
-    vec3f m_color;
-
-    /**
-     * @brief The world that the entity exists in.
-     */
-    World& m_world;
-
-    /**
-     * @brief The shape used to draw this entity.
-     */
-    sf::CircleShape m_shape;
-
-    /**
-     * @brief The current node that the entity is in.
-     */
-    HashNode* m_currentNode;
-
-    /**
-     * @brief The list of hash node that the entity exists in.
-     */
-    std::vector<HashNode*> m_hashNodes;
-
-    /**
-     * @brief Calculate the entities that are close to this entity.
-     * @param fullSearch = Should we search all of the nodes the entity exists in?
-     * @return the entities that are closest to this entity.
-     */
-    std::vector<Entity*> getNearEntities(bool fullSearch);
-
+    static void handleCollision(EntityStore& store, u32 a, u32 b);
 };
 
 #endif // ENTITY_H_INCLUDE
@@ -0,0 +1,249 @@
+#include "entitystore.h"
+
+// Standard includes.
+#include <algorithm>
+#include <utility>
+
+/**
+ * @brief Move the last element of an array into the index and shrink the array by one.
+ */
+template <typename T>
+void swapRemove(std::vector<T>& array, u32 index)
+{
+    if (index + 1 != array.size()) {
+        array[index] = std::move(array.back());
+    }
+
+    array.pop_back();
+}
+
+EntityStore::EntityStore() :
+    m_idCounter(0),
+    m_foodCount(0),
+    m_fireCount(0),
+    m_entityHighWater(0),
+    m_cellHighWater(0),
+    m_foodHighWater(0),
+    m_fireHighWater(0)
+{ }
+
+u32 EntityStore::addEntity(EntityType entityType, vec2f entityLocation)
+{
+    const u32 index = id.size();
+
+    // Reuse a free slot if we have one, the generation was already bumped when it was freed.
+    u32 slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else {
+        slot = m_slotIndex.size();
+        m_slotIndex.push_back(0);
+        m_slotGeneration.push_back(0);
+    }
+
+    m_slotIndex[slot] = index;
+    m_slots.push_back(slot);
+
+    id.push_back(m_idCounter++);
+    type.push_back(entityType);
+    alive.push_back(1);
+    location.push_back(entityLocation);
+    previousLocation.push_back(entityLocation);
+    velocity.push_back(vec2f());
+    friction.push_back(vec2f(1.0f));
+    radius.push_back(16.0f);
+    rotation.push_back(0.0f);
+    mass.push_back(1.0f);
+    color.push_back(vec3f(0.f));
+    component.push_back(0);
+
+    m_entityHighWater = std::max<u32>(m_entityHighWater, id.size());
+
+    return index;
+}
+
+u32 EntityStore::addCell(vec2f location, DNA&& dna)
+{
+    const u32 index = addEntity(EntityType::Cell, location);
+
+    component[index] = cells.size();
+
+    cells.entity.push_back(index);
+    cells.generation.push_back(0);
+    cells.foodAmount.push_back(CELL_MAX_FOOD);
+    cells.splitTimer.push_back(0.0f);
+    cells.memory.push_back(vec2f());
+    cells.dna.push_back(std::move(dna));
+
+    m_cellHighWater = std::max<u32>(m_cellHighWater, cells.size());
+
+    return index;
+}
+
+u32 EntityStore::addResource(type::ResourceType resourceType, vec2f location)
+{
+    const u32 index = addEntity(EntityType::Resource, location);
+
+    component[index] = resources.size();
+
+    resources.entity.push_back(index);
+    resources.resourceType.push_back(resourceType);
+    resources.amount.push_back(0.0f);
+    resources.max.push_back(0.0f);
+    resources.timer.push_back(0.0f);
+
+    if (resourceType == type::Food)
+        m_foodHighWater = std::max(m_foodHighWater, ++m_foodCount);
+    else if (resourceType == type::Fire)
+        m_fireHighWater = std::max(m_fireHighWater, ++m_fireCount);
+
+    return index;
+}
+
+void EntityStore::remove(u32 index)
+{
+    removeComponent(index);
+
+    const u32 last = id.size() - 1;
+
+    // Free the slot, bumping the generation invalidates any handles still pointing at it.
+    const u32 slot = m_slots[index];
+    m_slotGeneration[slot]++;
+    m_freeSlots.push_back(slot);
+
+    // The last entity is moved into the removed index, point its slot and component at the new index.
+    if (index != last) {
+
+        m_slotIndex[m_slots[last]] = index;
+
+        if (type[last] == EntityType::Cell)
+            cells.entity[component[last]] = index;
+        else
+            resources.entity[component[last]] = index;
+    }
+
+    swapRemove(m_slots, index);
+
+    swapRemove(id, index);
+    swapRemove(type, index);
+    swapRemove(alive, index);
+    swapRemove(location, index);
+    swapRemove(previousLocation, index);
+    swapRemove(velocity, index);
+    swapRemove(friction, index);
+    swapRemove(radius, index);
+    swapRemove(rotation, index);
+    swapRemove(mass, index);
+    swapRemove(color, index);
+    swapRemove(component, index);
+}
+
+void EntityStore::removeComponent(u32 index)
+{
+    const u32 removed = component[index];
+
+    if (type[index] == EntityType::Cell) {
+
+        const u32 last = cells.size() - 1;
+        if (removed != last)
+            component[cells.entity[last]] = removed;
+
+        swapRemove(cells.entity, removed);
+        swapRemove(cells.generation, removed);
+        swapRemove(cells.foodAmount, removed);
+        swapRemove(cells.splitTimer, removed);
+        swapRemove(cells.memory, removed);
+        swapRemove(cells.dna, removed);
+    }
+    else {
+
+        if (resources.resourceType[removed] == type::Food)
+            m_foodCount--;
+        else if (resources.resourceType[removed] == type::Fire)
+            m_fireCount--;
+
+        const u32 last = resources.size() - 1;
+        if (removed != last)
+            component[resources.entity[last]] = removed;
+
+        swapRemove(resources.entity, removed);
+        swapRemove(resources.resourceType, removed);
+        swapRemove(resources.amount, removed);
+        swapRemove(resources.max, removed);
+        swapRemove(resources.timer, removed);
+    }
+}
+
+void EntityStore::clear()
+{
+    while (size() > 0) {
+        remove(size() - 1);
+    }
+}
+
+void EntityStore::recount()
+{
+    m_foodCount = 0;
+    m_fireCount = 0;
+
+    for (u32 resource = 0; resource < resources.size(); resource++) {
+        if (resources.resourceType[resource] == type::Food)
+            m_foodCount++;
+        else if (resources.resourceType[resource] == type::Fire)
+            m_fireCount++;
+    }
+
+    m_entityHighWater = std::max<u32>(m_entityHighWater, id.size());
+    m_cellHighWater = std::max<u32>(m_cellHighWater, cells.size());
+    m_foodHighWater = std::max(m_foodHighWater, m_foodCount);
+    m_fireHighWater = std::max(m_fireHighWater, m_fireCount);
+}
+
+EntityStoreStats EntityStore::getStats() const
+{
+    EntityStoreStats stats;
+
+    stats.entities.count = id.size();
+    stats.entities.highWater = m_entityHighWater;
+    stats.entities.capacity = id.capacity();
+
+    stats.cells.count = cells.size();
+    stats.cells.highWater = m_cellHighWater;
+    stats.cells.capacity = cells.entity.capacity();
+
+    stats.food.count = m_foodCount;
+    stats.food.highWater = m_foodHighWater;
+    stats.food.capacity = resources.entity.capacity();
+
+    stats.fire.count = m_fireCount;
+    stats.fire.highWater = m_fireHighWater;
+    stats.fire.capacity = resources.entity.capacity();
+
+    stats.slotCount = m_slotIndex.size();
+    stats.freeSlotCount = m_freeSlots.size();
+
+    return stats;
+}
+
+EntityHandle EntityStore::getHandle(u32 index) const
+{
+    const u32 slot = m_slots[index];
+    return EntityHandle(slot, m_slotGeneration[slot]);
+}
+
+bool EntityStore::isValid(EntityHandle handle) const
+{
+    return handle.slot < m_slotGeneration.size() &&
+           m_slotGeneration[handle.slot] == handle.generation;
+}
+
+u32 EntityStore::getIndex(EntityHandle handle) const
+{
+    if (!isValid(handle)) {
+        return INVALID_INDEX;
+    }
+
+    return m_slotIndex[handle.slot];
+}
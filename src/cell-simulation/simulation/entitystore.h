@@ -0,0 +1,377 @@
+#ifndef ENTITYSTORE_H_INCLUDE
+#define ENTITYSTORE_H_INCLUDE
+
+// Standard includes.
+#include <vector>
+
+// SCL includes.
+#include <scl/types.h>
+#include <scl/math/vec2.h>
+#include <scl/math/vec3.h>
+
+// Project includes.
+#include "entity.h"
+#include "cell.h"
+#include "resource.h"
+#include "genetics/dna.h"
+
+/**
+ * @brief The per cell component data, indexed by the cell component index.
+ */
+struct CellComponents
+{
+    /**
+     * @brief The dense index of the entity that owns the component.
+     */
+    std::vector<u32> entity;
+
+    /**
+     * @brief The generation of the cell.
+     */
+    std::vector<i32> generation;
+
+    /**
+     * @brief The amount of food the cell currently has.
+     */
+    std::vector<r32> foodAmount;
+
+    /**
+     * @brief The simulation time in seconds since the cell last split.
+     */
+    std::vector<r32> splitTimer;
+
+    /**
+     * @brief The two memory registers fed back into the network.
+     */
+    std::vector<vec2f> memory;
+
+    /**
+     * @brief The genetic data of the cell.
+     */
+    std::vector<DNA> dna;
+
+    /**
+     * @brief Get the number of cells.
+     * @return The cell count.
+     */
+    u32 size() const { return entity.size(); }
+};
+
+/**
+ * @brief The per resource component data, indexed by the resource component index.
+ */
+struct ResourceComponents
+{
+    /**
+     * @brief The dense index of the entity that owns the component.
+     */
+    std::vector<u32> entity;
+
+    /**
+     * @brief The type of resource.
+     */
+    std::vector<type::ResourceType> resourceType;
+
+    /**
+     * @brief The current amount of resource available.
+     */
+    std::vector<r32> amount;
+
+    /**
+     * @brief The max amount of resource possible.
+     */
+    std::vector<r32> max;
+
+    /**
+     * @brief A general purpose timer, used by fire to wander around.
+     */
+    std::vector<r32> timer;
+
+    /**
+     * @brief Get the number of resources.
+     * @return The resource count.
+     */
+    u32 size() const { return entity.size(); }
+};
+
+/**
+ * @brief The usage of one of the pools in the entity store.
+ */
+struct PoolStats
+{
+    /**
+     * @brief The number of live entries.
+     */
+    u32 count = 0;
+
+    /**
+     * @brief The most entries there have been at once.
+     */
+    u32 highWater = 0;
+
+    /**
+     * @brief The number of entries that fit before the arrays have to grow.
+     */
+    u32 capacity = 0;
+};
+
+/**
+ * @brief The usage of the entity store.
+ * Food and fire share the resource arrays so their capacity is the resource capacity.
+ */
+struct EntityStoreStats
+{
+    PoolStats entities;
+    PoolStats cells;
+    PoolStats food;
+    PoolStats fire;
+
+    /**
+     * @brief The number of slots in the slot map.
+     */
+    u32 slotCount = 0;
+
+    /**
+     * @brief The number of slots waiting to be reused.
+     */
+    u32 freeSlotCount = 0;
+};
+
+/**
+ * @brief Stores every entity in the world as a structure of arrays.
+ *
+ * The shared physics data is kept in contiguous arrays indexed by a dense entity index,
+ * the type specific data lives in the component arrays. Removing an entity moves the last
+ * entity into its place so the arrays never have holes, which means dense indices are not
+ * stable. Use an EntityHandle to refer to an entity across updates.
+ *
+ * Each type is a pool, removing an entity keeps the capacity of the arrays and frees its
+ * slot for the next entity, so once the world has reached its peak size adding and removing
+ * entities never allocates.
+ */
+class EntityStore
+{
+public:
+    friend class Snapshot;
+
+    /**
+     * @brief The default entity store constructor.
+     */
+    EntityStore();
+
+    /**
+     * @brief Add a new resource entity, along with a default resource component.
+     * @param resourceType = The type of resource to add.
+     * @param location = The location of the entity.
+     * @return The dense index of the new entity.
+     */
+    u32 addResource(type::ResourceType resourceType, vec2f location);
+
+    /**
+     * @brief Add a new cell entity, along with a default cell component.
+     * @param location = The location of the entity.
+     * @param dna = The dna of the cell, moved into the component.
+     * @return The dense index of the new entity.
+     */
+    u32 addCell(vec2f location, DNA&& dna);
+
+    /**
+     * @brief Remove an entity and its component, the last entity is moved into its index.
+     * @param index = The dense index of the entity to remove.
+     */
+    void remove(u32 index);
+
+    /**
+     * @brief Remove all of the entities.
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of entities.
+     * @return The entity count.
+     */
+    u32 size() const { return id.size(); }
+
+    /**
+     * @brief Get the usage of the pools.
+     * @return The pool stats.
+     */
+    EntityStoreStats getStats() const;
+
+    /**
+     * @brief Get the stable handle for an entity.
+     * @param index = The dense index of the entity.
+     * @return The handle of the entity.
+     */
+    EntityHandle getHandle(u32 index) const;
+
+    /**
+     * @brief Check if a handle still refers to an entity.
+     * @param handle = The handle to check.
+     * @return True if the entity still exists.
+     */
+    bool isValid(EntityHandle handle) const;
+
+    /**
+     * @brief Get the dense index for a handle.
+     * @param handle = The handle to resolve.
+     * @return The dense index, or INVALID_INDEX if the entity no longer exists.
+     */
+    u32 getIndex(EntityHandle handle) const;
+
+    /**
+     * @brief Get the slot of an entity, the slot never changes while the entity exists.
+     * @param index = The dense index of the entity.
+     * @return The slot of the entity.
+     */
+    u32 getSlot(u32 index) const { return m_slots[index]; }
+
+    /**
+     * @brief Get the dense index of an entity by its slot.
+     * @param slot = The slot of the entity.
+     * @return The dense index of the entity.
+     */
+    u32 getSlotIndex(u32 slot) const { return m_slotIndex[slot]; }
+
+    /**
+     * @brief Get the location blended between the last two updates, used for rendering.
+     * @param index = The dense index of the entity.
+     * @param alpha = The blend factor, 0 for the previous location and 1 for the current.
+     * @return The interpolated entity location.
+     */
+    vec2f getInterpolatedLocation(u32 index, r32 alpha) const {
+        return previousLocation[index] + (location[index] - previousLocation[index]) * alpha;
+    }
+
+    /**
+     * @brief The unique id of each entity, never reused.
+     */
+    std::vector<u32> id;
+
+    /**
+     * @brief The type of each entity.
+     */
+    std::vector<EntityType> type;
+
+    /**
+     * @brief The state of each entity, zero once it has died.
+     */
+    std::vector<u8> alive;
+
+    /**
+     * @brief The location of each entity.
+     */
+    std::vector<vec2f> location;
+
+    /**
+     * @brief The location of each entity before the last update.
+     */
+    std::vector<vec2f> previousLocation;
+
+    /**
+     * @brief The velocity of each entity.
+     */
+    std::vector<vec2f> velocity;
+
+    /**
+     * @brief The friction of each entity.
+     */
+    std::vector<vec2f> friction;
+
+    /**
+     * @brief The radius of each entity.
+     */
+    std::vector<r32> radius;
+
+    /**
+     * @brief The rotation of each entity in radians.
+     */
+    std::vector<r32> rotation;
+
+    /**
+     * @brief The mass of each entity used for collision response.
+     */
+    std::vector<r32> mass;
+
+    /**
+     * @brief The color of each entity as seen by the cells.
+     */
+    std::vector<vec3f> color;
+
+    /**
+     * @brief The index of each entity in the component array of its type.
+     */
+    std::vector<u32> component;
+
+    /**
+     * @brief The cell components.
+     */
+    CellComponents cells;
+
+    /**
+     * @brief The resource components.
+     */
+    ResourceComponents resources;
+
+private:
+
+    /**
+     * @brief The counter used to give each entity a unique id.
+     */
+    u32 m_idCounter;
+
+    /**
+     * @brief The slot of each entity, indexed by dense index.
+     */
+    std::vector<u32> m_slots;
+
+    /**
+     * @brief The dense index of each slot.
+     */
+    std::vector<u32> m_slotIndex;
+
+    /**
+     * @brief The generation of each slot, bumped every time the slot is freed.
+     */
+    std::vector<u32> m_slotGeneration;
+
+    /**
+     * @brief The slots that are free to be reused.
+     */
+    std::vector<u32> m_freeSlots;
+
+    /**
+     * @brief The number of live food and fire resources.
+     */
+    u32 m_foodCount;
+    u32 m_fireCount;
+
+    /**
+     * @brief The most entities of each type there have been at once.
+     */
+    u32 m_entityHighWater;
+    u32 m_cellHighWater;
+    u32 m_foodHighWater;
+    u32 m_fireHighWater;
+
+    /**
+     * @brief Count the resources of each type again, used after the arrays were replaced.
+     */
+    void recount();
+
+    /**
+     * @brief Add the shared data for a new entity, the caller adds the component.
+     * @param type = The type of the entity.
+     * @param location = The location of the entity.
+     * @return The dense index of the new entity.
+     */
+    u32 addEntity(EntityType type, vec2f location);
+
+    /**
+     * @brief Remove the component of an entity, the last component is moved into its index.
+     * @param index = The dense index of the entity that owns the component.
+     */
+    void removeComponent(u32 index);
+};
+
+#endif // ENTITYSTORE_H_INCLUDE
@@ -0,0 +1,133 @@
+#include "eventstream.h"
+
+#include <util/log.h>
+
+#include <cstring>
+
+EventStream::EventStream() :
+    m_open(false),
+    m_recordCollisions(false),
+    m_lastTick(0),
+    m_tickWritten(false),
+    m_eventCount(0)
+{ }
+
+EventStream::~EventStream()
+{
+    close();
+}
+
+bool EventStream::open(const std::string& filePath, bool recordCollisions)
+{
+    close();
+
+    EventHeader header;
+    std::memcpy(header.magic, EVENT_MAGIC, sizeof(header.magic));
+    header.version = EVENT_VERSION;
+    header.recordSize = sizeof(EventRecord);
+    header.reserved = 0;
+
+    // Only append to a file written with the same layout that ends on a whole record,
+    // anything else would throw every record after it out of line.
+    std::ifstream existing(filePath.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+    if (existing.is_open()) {
+
+        const u64 size = (u64)existing.tellg();
+
+        if (size > 0) {
+
+            EventHeader found;
+            existing.seekg(0);
+            existing.read((char*)&found, sizeof(found));
+
+            if (size < sizeof(found) || std::memcmp(&found, &header, sizeof(header)) != 0) {
+                Log::error("the event file has a different format, not recording events: ", filePath);
+                return false;
+            }
+
+            if ((size - sizeof(header)) % sizeof(EventRecord) != 0) {
+                Log::error("the event file ends with a partial record, not recording events: ", filePath);
+                return false;
+            }
+        }
+
+        existing.close();
+    }
+
+    m_file.open(filePath.c_str(), std::ios::out | std::ios::binary | std::ios::app);
+
+    if (!m_file.is_open()) {
+        Log::error("failed to open the event file: ", filePath);
+        return false;
+    }
+
+    if (m_file.tellp() == 0)
+        m_file.write((const char*)&header, sizeof(header));
+
+    m_buffer.reserve(EVENT_BUFFER_SIZE / sizeof(EventRecord));
+
+    m_open = true;
+    m_recordCollisions = recordCollisions;
+    m_tickWritten = false;
+    m_eventCount = 0;
+
+    return true;
+}
+
+void EventStream::close()
+{
+    if (!m_open)
+        return;
+
+    flush();
+
+    m_file.close();
+    m_open = false;
+}
+
+void EventStream::flush()
+{
+    if (!m_open || m_buffer.empty())
+        return;
+
+    m_file.write((const char*)m_buffer.data(), m_buffer.size() * sizeof(EventRecord));
+    m_file.flush();
+
+    m_buffer.clear();
+}
+
+void EventStream::consume(u64 tick, u32 cell, u32 resource, u8 resourceType, r32 amount)
+{
+    if (!m_open)
+        return;
+
+    u32 data;
+    std::memcpy(&data, &amount, sizeof(data));
+
+    append(tick, event::Consume, resourceType, cell, resource, data);
+}
+
+void EventStream::append(u64 tick, u8 type, u8 detail, u32 entity, u32 other, u32 data)
+{
+    if (!m_tickWritten || tick != m_lastTick) {
+
+        const EventRecord tickRecord = { event::Tick, 0, 0, (u32)tick, (u32)(tick >> 32), 0 };
+        write(tickRecord);
+
+        m_lastTick = tick;
+        m_tickWritten = true;
+    }
+
+    const EventRecord record = { type, detail, 0, entity, other, data };
+    write(record);
+
+    m_eventCount++;
+}
+
+void EventStream::write(const EventRecord& record)
+{
+    m_buffer.push_back(record);
+
+    if (m_buffer.size() * sizeof(EventRecord) >= EVENT_BUFFER_SIZE)
+        flush();
+}
@@ -0,0 +1,257 @@
+#ifndef EVENTSTREAM_H_INCLUDE
+#define EVENTSTREAM_H_INCLUDE
+
+// Standard includes.
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <scl/types.h>
+
+/**
+ * @brief Where the population events are recorded.
+ */
+const std::string EVENT_FILE_PATH = "../../data/events.bin";
+
+/**
+ * @brief Identifies an event file, the first four bytes of the file.
+ */
+const char EVENT_MAGIC[4] = { 'C', 'E', 'V', 'T' };
+
+/**
+ * @brief The current version of the event file, bump it when the layout changes.
+ */
+const u32 EVENT_VERSION = 1;
+
+/**
+ * @brief The entity id used when an event has no other entity, like a cell that wasn't born from a split.
+ */
+const u32 NO_ENTITY = 0xffffffff;
+
+/**
+ * @brief The number of bytes buffered before they are written to the file.
+ */
+const u32 EVENT_BUFFER_SIZE = 64 * 1024;
+
+namespace event
+{
+    /**
+     * @brief The kind of an event record.
+     */
+    enum EventType : u8
+    {
+        // The events after it happened on this tick, entity and other hold the low and high halves of the tick.
+        Tick = 0,
+
+        // A cell was added, other is its parent and data its generation.
+        Birth = 1,
+
+        // An entity was removed, detail is the cause.
+        Death = 2,
+
+        // A cell ate from a resource, other is the resource, detail the resource type and data the amount as a float.
+        Consume = 3,
+
+        // Two entities touched, other is the entity it touched.
+        Collision = 4
+    };
+
+    /**
+     * @brief Why an entity died.
+     */
+    enum DeathCause : u8
+    {
+        // A cell ran out of food.
+        Starved = 0,
+
+        // A cell lost its mass to bigger cells.
+        Eaten = 1,
+
+        // A resource was used up.
+        Depleted = 2
+    };
+}
+
+/**
+ * @brief The header at the start of an event file.
+ */
+struct EventHeader
+{
+    char magic[4];
+    u32 version;
+    u32 recordSize;
+    u32 reserved;
+};
+
+/**
+ * @brief One event in an event file, the entities are given by their unique ids.
+ */
+struct EventRecord
+{
+    u8 type;
+    u8 detail;
+    u16 reserved;
+    u32 entity;
+    u32 other;
+    u32 data;
+};
+
+/**
+ * @brief Records the births, deaths, consumption and collisions of a world into an append only binary file.
+ *
+ * The events are fixed size records, buffered in memory and written out in large blocks so the
+ * simulation never formats any text or waits on a small write. Each tick that has events starts
+ * with a tick record and every event after it happened on that tick. A run that resumes carries
+ * on appending to the same file. The cell-events tool turns the file into csv tables.
+ * Nothing is recorded until the stream is opened, so a closed stream costs one branch per event.
+ */
+class EventStream
+{
+public:
+
+    /**
+     * @brief Create a closed event stream.
+     */
+    EventStream();
+
+    /**
+     * @brief Write out the buffered events and close the file.
+     */
+    ~EventStream();
+
+    EventStream(const EventStream&) = delete;
+    EventStream& operator=(const EventStream&) = delete;
+
+    /**
+     * @brief Open an event file to append to, the header is written if the file is new.
+     * @param filePath = The path of the file.
+     * @param recordCollisions = Record every collision too, by far the most common event.
+     * @return True if sucessful.
+     */
+    bool open(const std::string& filePath, bool recordCollisions);
+
+    /**
+     * @brief Write out the buffered events and close the file.
+     */
+    void close();
+
+    /**
+     * @brief Write out the buffered events.
+     */
+    void flush();
+
+    /**
+     * @brief Check if events are being recorded.
+     * @return True if the stream is open.
+     */
+    bool isOpen() const { return m_open; }
+
+    /**
+     * @brief Get the number of events recorded since the stream was opened.
+     * @return The event count, not counting the tick records.
+     */
+    u64 getEventCount() const { return m_eventCount; }
+
+    /**
+     * @brief Record a cell being added to the world.
+     * @param tick = The current tick.
+     * @param id = The id of the new cell.
+     * @param parent = The id of the cell it split from, NO_ENTITY if it didn't.
+     * @param generation = The generation of the new cell.
+     */
+    void birth(u64 tick, u32 id, u32 parent, i32 generation)
+    {
+        if (m_open)
+            append(tick, event::Birth, 0, id, parent, (u32)generation);
+    }
+
+    /**
+     * @brief Record an entity being removed from the world.
+     * @param tick = The current tick.
+     * @param id = The id of the entity.
+     * @param cause = Why it died.
+     */
+    void death(u64 tick, u32 id, event::DeathCause cause)
+    {
+        if (m_open)
+            append(tick, event::Death, cause, id, NO_ENTITY, 0);
+    }
+
+    /**
+     * @brief Record a cell eating from a resource.
+     * @param tick = The current tick.
+     * @param cell = The id of the cell.
+     * @param resource = The id of the resource.
+     * @param resourceType = The type of the resource.
+     * @param amount = The amount eaten.
+     */
+    void consume(u64 tick, u32 cell, u32 resource, u8 resourceType, r32 amount);
+
+    /**
+     * @brief Record two entities touching.
+     * @param tick = The current tick.
+     * @param id = The id of the first entity.
+     * @param other = The id of the other entity.
+     */
+    void collision(u64 tick, u32 id, u32 other)
+    {
+        if (m_open && m_recordCollisions)
+            append(tick, event::Collision, 0, id, other, 0);
+    }
+
+private:
+
+    /**
+     * @brief Add an event to the buffer, after a tick record if it is the first event of the tick.
+     * @param tick = The current tick.
+     * @param type = The event type.
+     * @param detail = The small value that goes with the event type.
+     * @param entity = The id of the entity the event is about.
+     * @param other = The id of the other entity, NO_ENTITY if there isn't one.
+     * @param data = The value that goes with the event type.
+     */
+    void append(u64 tick, u8 type, u8 detail, u32 entity, u32 other, u32 data);
+
+    /**
+     * @brief Add a record to the buffer, writing the buffer out once it is full.
+     * @param record = The record to add.
+     */
+    void write(const EventRecord& record);
+
+    /**
+     * @brief The file the events are appended to.
+     */
+    std::ofstream m_file;
+
+    /**
+     * @brief The records waiting to be written.
+     */
+    std::vector<EventRecord> m_buffer;
+
+    /**
+     * @brief Set while the stream is open.
+     */
+    bool m_open;
+
+    /**
+     * @brief Set when collisions are recorded.
+     */
+    bool m_recordCollisions;
+
+    /**
+     * @brief The tick of the last tick record, so it is only written once per tick.
+     */
+    u64 m_lastTick;
+
+    /**
+     * @brief Set once a tick record has been written since the stream was opened.
+     */
+    bool m_tickWritten;
+
+    /**
+     * @brief The number of events recorded since the stream was opened.
+     */
+    u64 m_eventCount;
+};
+
+#endif // EVENTSTREAM_H_INCLUDE
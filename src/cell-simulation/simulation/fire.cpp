@@ -1,29 +1,39 @@
 #include "fire.h"
+#include "entitystore.h"
+#include "world.h"
 #include "../mathutils.h"
 #include "randomgen.h"
 
-Fire::Fire(vec2f location, World& world) :
-    Resource(RandomGen::randomFloat(50.0f, 100.0f), location, world, type::Fire)
+u32 Fire::create(World& world, vec2f location, RandomGen& random)
 {
-    m_mass = (m_amount / 100.0f) * 50.0f;
-    m_friction = {0.99f, 0.99f};
-    m_shape.setFillColor(sf::Color::Red);
-    m_shape.setPosition(m_location.x, m_location.y);
-    m_shape.setPointCount(32);
-    m_shape.setOutlineThickness(0.0f);
-    m_color = vec3f(128, 128.f, 128.f) / 255.0f;
-    m_amount = 100.0f;
-}
+    const u32 index = Resource::create(world, random.randomFloat(50.0f, 100.0f), location, type::Fire);
+
+    EntityStore& store = world.getStore();
+    const u32 resource = store.component[index];
 
+    store.mass[index] = (store.resources.amount[resource] / 100.0f) * 50.0f;
+    store.friction[index] = {0.99f, 0.99f};
+    store.color[index] = vec3f(128, 128.f, 128.f) / 255.0f;
+    store.resources.amount[resource] = 100.0f;
 
-void Fire::update(const r32 dt)
+    return index;
+}
+
+void Fire::update(World& world, u32 resource, const r32 dt)
 {
-    dtCounter += dt;
-    if (dtCounter >= 1.0f) {
-        dtCounter = 0;
-        m_velocity.x += RandomGen::randomFloat(-1.f, 1.f) * 10.0f;
-        m_velocity.y += RandomGen::randomFloat(-1.f, 1.f) * 10.0f;
-    }
+    EntityStore& store = world.getStore();
 
-    Resource::update(dt);
+    r32& timer = store.resources.timer[resource];
+
+    timer += dt;
+    if (timer >= 1.0f) {
+        timer = 0;
+
+        const u32 index = store.resources.entity[resource];
+        RandomGen random(world.getSeed(), store.id[index], world.getTick(), RandomPurpose::Wander);
+
+        vec2f& velocity = store.velocity[index];
+        velocity.x += random.randomFloat(-1.f, 1.f) * 10.0f;
+        velocity.y += random.randomFloat(-1.f, 1.f) * 10.0f;
+    }
 }
@@ -4,25 +4,31 @@
 // Project includes.
 #include "resource.h"
 
+class RandomGen;
+
 /**
- * @brief This class represents a food resource in the world.
+ * @brief This class contains the behaviour of the fire resources in the world.
  */
-class Fire : public Resource
+class Fire
 {
 public:
 
     /**
-     * @brief The default food constructor.
-     * @param location = The location of the food resource.
+     * @brief Create a new fire resource.
      * @param world = The world the resource exists in.
+     * @param location = The location of the fire resource.
+     * @param random = The random stream to draw the amount from.
+     * @return The dense entity index of the new fire.
      */
-    Fire(vec2f location, World& world);
-
-    void update(const r32 dt);
-
-private:
+    static u32 create(World& world, vec2f location, RandomGen& random);
 
-    r32 dtCounter = 0;
+    /**
+     * @brief Let the fire wander around the world.
+     * @param world = The world the resource exists in.
+     * @param resource = The resource component index.
+     * @param dt = The delta time.
+     */
+    static void update(World& world, u32 resource, const r32 dt);
 };
 
 #endif // FIRE_H_INCLUDE
@@ -4,19 +4,23 @@
 // Project includes.
 #include "resource.h"
 
+class RandomGen;
+
 /**
- * @brief This class represents a food resource in the world.
+ * @brief This class creates the food resources in the world.
  */
-class Food : public Resource
+class Food
 {
 public:
 
     /**
-     * @brief The default food constructor.
-     * @param location = The location of the food resource.
+     * @brief Create a new food resource.
      * @param world = The world the resource exists in.
+     * @param location = The location of the food resource.
+     * @param random = The random stream to draw the amount from.
+     * @return The dense entity index of the new food.
      */
-    Food(vec2f location, World& world);
+    static u32 create(World& world, vec2f location, RandomGen& random);
 };
 
 #endif // FOOD_H_INCLUDE
@@ -16,13 +16,14 @@ public:
     /**
      * @brief Replicate the parent dna with random mutations.
      * @param parent = The dna genome.
+     * @param random = The random stream to draw the mutations from.
      * @return The dna genome.
      */
-    static DNA replicate(const DNA& parent);
+    static DNA replicate(const DNA& parent, RandomGen& random);
 
 private:
 
-    static Genome replicateGenome(const DNA& parent);
+    static Genome replicateGenome(const DNA& parent, RandomGen& random);
 };
 
 #endif // BREEDER_H_INCLUDE
@@ -1,14 +1,19 @@
 #include "dna.h"
 
 // Standard includes.
-#include <memory>
+#include <utility>
 
 DNA::DNA() :
-    genome(std::move(Genome())),
-    traits(Traits())
+    genome(),
+    traits()
+{ }
+
+DNA::DNA(RandomGen& random) :
+    genome(random),
+    traits(random)
 { }
 
 DNA::DNA(Genome&& genome, Traits traits) :
-    genome(genome),
+    genome(std::move(genome)),
     traits(traits)
 { }
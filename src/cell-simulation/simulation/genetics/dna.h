@@ -10,8 +10,17 @@
 struct DNA
 {
 
+    /**
+     * @brief Create dna with zeroed traits and weights, used when they are about to be filled in.
+     */
     DNA();
 
+    /**
+     * @brief Create random dna.
+     * @param random = The random stream to draw from.
+     */
+    explicit DNA(RandomGen& random);
+
     DNA(Genome&& genome, Traits traits);
 
     /**
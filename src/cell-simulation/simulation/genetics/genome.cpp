@@ -2,9 +2,11 @@
 
 // Standard includes.
 #include <algorithm>
+#include <cassert>
 
 // Project includes.
 #include "../world.h"
+#include "genomepool.h"
 
 // SCL includes.
 #include <scl/math/help.h>
@@ -16,46 +18,64 @@
 // Default constructor.
 Genome::Genome() :
     m_length(World::m_weightCount),
-    m_weights(new r32[World::m_weightCount]) {
+    m_weights(GenomePool::allocate()) {
+    std::fill(m_weights, m_weights + m_length, 0.0f);
+}
+
+// Random constructor.
+Genome::Genome(RandomGen& random) :
+    m_length(World::m_weightCount),
+    m_weights(GenomePool::allocate()) {
     // Move theses first values into a trait class?
     for (u32 i = 0; i < m_length; i++) {
-        m_weights[i] = Genome::randomGenomeWeight();
+        m_weights[i] = Genome::randomGenomeWeight(random);
     }
 }
 
+// Weight copy constructor.
+Genome::Genome(const r32* weights, u32 length) :
+    m_length(length),
+    m_weights(GenomePool::allocate()) {
+    // Every pool block is sized to the network.
+    assert(length == World::m_weightCount);
+    std::copy(weights, weights + m_length, m_weights);
+}
+
 // Copy constructor.
 Genome::Genome(const Genome& other) :
     m_length(other.m_length),
-    m_weights(new r32[other.m_length]) {
+    m_weights(other.m_weights ? GenomePool::allocate() : 0) {
     std::copy(other.m_weights, other.m_weights + m_length, m_weights);
 }
 
 // Move constructor.
-Genome::Genome(Genome&& other) :
-    m_length(0),
-    m_weights(0) {
-    *this = std::move(other);
+Genome::Genome(Genome&& other) noexcept :
+    m_length(other.m_length),
+    m_weights(other.m_weights) {
+    other.m_weights = 0;
+    other.m_length = 0;
 }
 
 // Default destructor.
 Genome::~Genome() {
-    if (m_weights) {
-        delete [] m_weights;
-        m_weights = 0;
-    }
+    GenomePool::release(m_weights);
+    m_weights = 0;
 }
 
 // Copy assignment operator.
 Genome& Genome::operator=(const Genome& other) {
     if (this != &other) {
 
-        if (m_weights) {
-            delete m_weights;
+        // The blocks are all the same size so an existing one can be copied over.
+        if (!other.m_weights) {
+            GenomePool::release(m_weights);
             m_weights = 0;
         }
+        else if (!m_weights) {
+            m_weights = GenomePool::allocate();
+        }
 
         m_length = other.m_length;
-        m_weights = new r32[m_length];
 
         std::copy(other.m_weights, other.m_weights + m_length, m_weights);
     }
@@ -64,13 +84,10 @@ Genome& Genome::operator=(const Genome& other) {
 }
 
 // Move assignment operator.
-Genome& Genome::operator =(Genome&& other) {
+Genome& Genome::operator =(Genome&& other) noexcept {
     if (this != &other) {
 
-        if (m_weights) {
-            delete m_weights;
-            m_weights = 0;
-        }
+        GenomePool::release(m_weights);
 
         m_weights = other.m_weights;
         m_length = other.m_length;
@@ -81,3 +98,18 @@ Genome& Genome::operator =(Genome&& other) {
 
     return *this;
 }
+
+// Weight hash.
+u64 Genome::getHash() const {
+    u64 hash = 0xcbf29ce484222325ULL;
+
+    const u8* bytes = (const u8*)m_weights;
+    const u64 size = m_weights ? (u64)m_length * sizeof(r32) : 0;
+
+    for (u64 i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
@@ -15,10 +15,23 @@ public:
     friend class GenomePool;
 
     /**
-     * @brief The default genome constructor. (Generates a random set of weights)
+     * @brief The default genome constructor. (The weights are zeroed, used when they are about to be filled in)
      */
     Genome();
 
+    /**
+     * @brief Create a genome with a random set of weights.
+     * @param random = The random stream to draw from.
+     */
+    explicit Genome(RandomGen& random);
+
+    /**
+     * @brief Create a genome from a copy of some existing weights.
+     * @param weights = The weights to copy.
+     * @param length = The number of weights.
+     */
+    Genome(const r32* weights, u32 length);
+
     /**
      * @brief The genome copy constructor.
      * @param other = The genome to copy from.
@@ -26,10 +39,10 @@ public:
     Genome(const Genome& other);
 
     /**
-     * @brief The gneome move constructor.
+     * @brief The gneome move constructor, noexcept so growing a vector of genomes moves them rather than copying.
      * @param other = The genome to move from.
      */
-    Genome(Genome&& other);
+    Genome(Genome&& other) noexcept;
 
     /**
      * @brief The default genome destructor.
@@ -48,7 +61,7 @@ public:
      * @param other = The other genome to move into this one.
      * @return The new genome.
      */
-    Genome& operator=(Genome&& other);
+    Genome& operator=(Genome&& other) noexcept;
 
     /**
      * @brief Get a pointer to the weights which can be written to here.
@@ -68,11 +81,18 @@ public:
      */
     i32 getLength() const { return m_length; }
 
+    /**
+     * @brief Hash the weights, genomes with the same weights have the same hash.
+     * @return The 64 bit FNV-1a hash of the weight bytes.
+     */
+    u64 getHash() const;
+
     /**
      * @brief Generate a random inital genome weight.
+     * @param random = The random stream to draw from.
      * @return The random weight value.
      */
-    inline static r32 randomGenomeWeight() { return RandomGen::randomFloat(-1.0f, 1.0f); }
+    inline static r32 randomGenomeWeight(RandomGen& random) { return random.randomFloat(-1.0f, 1.0f); }
 
 private:
 
@@ -0,0 +1,102 @@
+#include "genomepool.h"
+
+// Standard includes.
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Project includes.
+#include "../world.h"
+
+/**
+ * @brief The pool state, created on first use and never destroyed so genomes
+ * released during static destruction still have somewhere to go.
+ */
+struct GenomePoolState
+{
+    std::mutex mutex;
+    std::vector<char*> slabs;
+
+    /**
+     * @brief The head of the free list, each free block holds the next pointer.
+     */
+    char* freeList = 0;
+
+    GenomePoolStats stats;
+};
+
+static GenomePoolState& getState()
+{
+    static GenomePoolState* state = new GenomePoolState();
+    return *state;
+}
+
+/**
+ * @brief Carve a new slab into blocks and push them all onto the free list.
+ */
+static void addSlab(GenomePoolState& state)
+{
+    const u32 blockSize = state.stats.blockSize;
+
+    char* slab = new char[(blockSize * GENOME_POOL_SLAB_BLOCKS) + GENOME_POOL_ALIGNMENT];
+    state.slabs.push_back(slab);
+
+    const std::uintptr_t address = (std::uintptr_t)slab;
+    char* blocks = slab + ((GENOME_POOL_ALIGNMENT - (address % GENOME_POOL_ALIGNMENT)) % GENOME_POOL_ALIGNMENT);
+
+    // Push them in reverse so the blocks are handed out in address order.
+    for (i32 i = GENOME_POOL_SLAB_BLOCKS - 1; i >= 0; i--) {
+        char* block = blocks + (i * blockSize);
+        *(char**)block = state.freeList;
+        state.freeList = block;
+    }
+
+    state.stats.slabCount++;
+    state.stats.blockCount += GENOME_POOL_SLAB_BLOCKS;
+}
+
+r32* GenomePool::allocate()
+{
+    GenomePoolState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    if (state.stats.blockSize == 0) {
+        const u32 weightSize = std::max<u32>(World::m_weightCount * sizeof(r32), sizeof(char*));
+        state.stats.blockSize = ((weightSize + GENOME_POOL_ALIGNMENT - 1) / GENOME_POOL_ALIGNMENT) * GENOME_POOL_ALIGNMENT;
+    }
+
+    if (!state.freeList)
+        addSlab(state);
+
+    char* block = state.freeList;
+    state.freeList = *(char**)block;
+
+    state.stats.usedCount++;
+    state.stats.highWater = std::max(state.stats.highWater, state.stats.usedCount);
+
+    return (r32*)block;
+}
+
+void GenomePool::release(r32* weights)
+{
+    if (!weights)
+        return;
+
+    GenomePoolState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    char* block = (char*)weights;
+    *(char**)block = state.freeList;
+    state.freeList = block;
+
+    state.stats.usedCount--;
+}
+
+GenomePoolStats GenomePool::getStats()
+{
+    GenomePoolState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    return state.stats;
+}
@@ -0,0 +1,78 @@
+#ifndef GENOMEPOOL_H_INCLUDE
+#define GENOMEPOOL_H_INCLUDE
+
+#include <scl/types.h>
+
+/**
+ * @brief The alignment of each genome weight buffer, one cache line.
+ */
+const u32 GENOME_POOL_ALIGNMENT = 64;
+
+/**
+ * @brief The number of weight buffers carved out of each slab.
+ */
+const u32 GENOME_POOL_SLAB_BLOCKS = 256;
+
+/**
+ * @brief The usage of the genome pool.
+ */
+struct GenomePoolStats
+{
+    /**
+     * @brief The size of each block in bytes, the weights rounded up to the alignment.
+     */
+    u32 blockSize = 0;
+
+    /**
+     * @brief The number of slabs allocated.
+     */
+    u32 slabCount = 0;
+
+    /**
+     * @brief The number of blocks in all of the slabs.
+     */
+    u32 blockCount = 0;
+
+    /**
+     * @brief The number of blocks owned by a genome.
+     */
+    u32 usedCount = 0;
+
+    /**
+     * @brief The most blocks that have been in use at once.
+     */
+    u32 highWater = 0;
+};
+
+/**
+ * @brief Hands out the weight buffers of the genomes.
+ *
+ * Every genome has the same number of weights so the buffers are fixed size blocks,
+ * carved out of large slabs and aligned to a cache line. Freed blocks go on a free list
+ * and are handed straight back out, so once the population has peaked the constant
+ * split and death churn never goes to the heap. The slabs are never returned.
+ */
+class GenomePool
+{
+public:
+
+    /**
+     * @brief Take a block sized to World::m_weightCount weights, the contents are undefined.
+     * @return The block.
+     */
+    static r32* allocate();
+
+    /**
+     * @brief Return a block to the pool.
+     * @param weights = The block to return, may be null.
+     */
+    static void release(r32* weights);
+
+    /**
+     * @brief Get the usage of the pool.
+     * @return The pool stats.
+     */
+    static GenomePoolStats getStats();
+};
+
+#endif // GENOMEPOOL_H_INCLUDE
@@ -0,0 +1,160 @@
+#include "population.h"
+
+// Standard includes.
+#include <cstring>
+#include <vector>
+
+// Project includes.
+#include "../entitystore.h"
+#include "../neuralnetwork.h"
+
+#include <util/binarystream.h>
+#include <util/log.h>
+
+/**
+ * @brief The generation and the ten trait values come before the weights.
+ */
+const u32 RECORD_TRAITS_SIZE = 11 * sizeof(u32);
+
+template <typename T>
+static T readValue(const char*& data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    return value;
+}
+
+bool PopulationFile::save(const std::string& filePath, const CellComponents& cells, const NeuralNetwork& network)
+{
+    const u32 weightCount = network.getWeightCount();
+
+    PopulationHeader header;
+    std::memcpy(header.magic, POPULATION_MAGIC, sizeof(header.magic));
+    header.version = POPULATION_VERSION;
+    header.inputCount = network.getInputCount();
+    header.hiddenCount = network.getHiddenCount();
+    header.outputCount = network.getOutputCount();
+    header.weightCount = weightCount;
+    header.entityCount = cells.size();
+    header.recordSize = RECORD_TRAITS_SIZE + (weightCount * sizeof(r32));
+    header.reserved = 0;
+
+    std::vector<char> buffer;
+    buffer.reserve(sizeof(header) + (header.entityCount * header.recordSize));
+
+    BinaryWriter out(buffer);
+    out.write(header);
+
+    for (u32 cell = 0; cell < cells.size(); cell++) {
+
+        const Traits& traits = cells.dna[cell].traits;
+
+        out.write((i32)cells.generation[cell]);
+        out.write(traits.mutationRate);
+        out.write(traits.splitRate);
+        out.write(traits.red);
+        out.write(traits.green);
+        out.write(traits.blue);
+        out.write(traits.eyeOffsetA);
+        out.write(traits.eyeOffsetB);
+        out.write(traits.eyeLengthA);
+        out.write(traits.eyeLengthB);
+        out.write(traits.eyeLengthC);
+
+        out.writeBytes(cells.dna[cell].genome.readWeights(), weightCount * sizeof(r32));
+    }
+
+    if (!writeFileAtomic(filePath, buffer.data(), buffer.size())) {
+        Log::error("failed to write population file: " + filePath);
+        return false;
+    }
+
+    return true;
+}
+
+bool PopulationFile::open(const std::string& filePath, const NeuralNetwork& network)
+{
+    m_entityCount = 0;
+    m_recordSize = 0;
+
+    if (!m_file.open(filePath)) {
+        return false;
+    }
+
+    if (m_file.getSize() < sizeof(PopulationHeader)) {
+        Log::error("population file is too small: " + filePath);
+        m_file.close();
+        return false;
+    }
+
+    PopulationHeader header;
+    std::memcpy(&header, m_file.getData(), sizeof(header));
+
+    if (std::memcmp(header.magic, POPULATION_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != POPULATION_VERSION) {
+
+        Log::error("unknown population file format: " + filePath);
+        m_file.close();
+        return false;
+    }
+
+    // The genomes only make sense to the network they were evolved for.
+    if (header.inputCount != network.getInputCount() ||
+        header.hiddenCount != network.getHiddenCount() ||
+        header.outputCount != network.getOutputCount() ||
+        header.weightCount != network.getWeightCount() ||
+        header.recordSize != RECORD_TRAITS_SIZE + (header.weightCount * sizeof(r32))) {
+
+        Log::error("population file was saved for a different network: " + filePath);
+        m_file.close();
+        return false;
+    }
+
+    if (m_file.getSize() < sizeof(PopulationHeader) + (header.entityCount * header.recordSize)) {
+        Log::error("population file is truncated: " + filePath);
+        m_file.close();
+        return false;
+    }
+
+    m_entityCount = header.entityCount;
+    m_recordSize = header.recordSize;
+
+    return true;
+}
+
+const char* PopulationFile::getRecord(u64 index) const
+{
+    return m_file.getData() + sizeof(PopulationHeader) + (index * m_recordSize);
+}
+
+i32 PopulationFile::getGeneration(u64 index) const
+{
+    const char* data = getRecord(index);
+    return readValue<i32>(data);
+}
+
+Traits PopulationFile::getTraits(u64 index) const
+{
+    const char* data = getRecord(index) + sizeof(i32);
+
+    Traits traits;
+    traits.mutationRate = readValue<i32>(data);
+    traits.splitRate = readValue<r32>(data);
+    traits.red = readValue<r32>(data);
+    traits.green = readValue<r32>(data);
+    traits.blue = readValue<r32>(data);
+    traits.eyeOffsetA = readValue<r32>(data);
+    traits.eyeOffsetB = readValue<r32>(data);
+    traits.eyeLengthA = readValue<r32>(data);
+    traits.eyeLengthB = readValue<r32>(data);
+    traits.eyeLengthC = readValue<r32>(data);
+
+    return traits;
+}
+
+const r32* PopulationFile::getWeights(u64 index) const
+{
+    // The header and the records are multiples of four bytes so the weights are aligned.
+    return (const r32*)(getRecord(index) + RECORD_TRAITS_SIZE);
+}
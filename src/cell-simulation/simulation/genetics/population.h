@@ -0,0 +1,123 @@
+#ifndef POPULATION_H_INCLUDE
+#define POPULATION_H_INCLUDE
+
+// Standard includes.
+#include <string>
+
+#include <scl/types.h>
+
+// Project includes.
+#include "traits.h"
+#include <util/mappedfile.h>
+
+class NeuralNetwork;
+struct CellComponents;
+
+/**
+ * @brief Identifies a population file, the first four bytes of the file.
+ */
+const char POPULATION_MAGIC[4] = { 'C', 'P', 'O', 'P' };
+
+/**
+ * @brief The current version of the population file, bump it when the layout changes.
+ */
+const u32 POPULATION_VERSION = 1;
+
+/**
+ * @brief The header at the start of a population file.
+ * Every field is four or eight bytes in the byte order of the machine that wrote it.
+ */
+struct PopulationHeader
+{
+    char magic[4];
+    u32 version;
+    u32 inputCount;
+    u32 hiddenCount;
+    u32 outputCount;
+    u32 weightCount;
+    u64 entityCount;
+    u32 recordSize;
+    u32 reserved;
+};
+
+/**
+ * @brief A binary file holding the dna of every cell.
+ * After the header come entityCount records of recordSize bytes, the generation,
+ * the traits in declaration order and then the genome weights.
+ * The file is memory mapped when it is read so the records are used in place.
+ */
+class PopulationFile
+{
+public:
+
+    /**
+     * @brief Write the dna of all of the cells to a population file.
+     * The file is written next to the old one and then swapped in so a crash never leaves half a file.
+     * @param filePath = The path of the file to write.
+     * @param cells = The cells to write.
+     * @param network = The network the genomes belong to.
+     * @return True if sucessful.
+     */
+    static bool save(const std::string& filePath, const CellComponents& cells, const NeuralNetwork& network);
+
+    /**
+     * @brief Map a population file and check it matches the network.
+     * @param filePath = The path of the file to open.
+     * @param network = The network the genomes have to belong to.
+     * @return True if the file exists and is valid.
+     */
+    bool open(const std::string& filePath, const NeuralNetwork& network);
+
+    /**
+     * @brief Get the number of cells in the file.
+     * @return The cell count.
+     */
+    u64 getEntityCount() const { return m_entityCount; }
+
+    /**
+     * @brief Get the generation of a cell.
+     * @param index = The index of the record.
+     * @return The generation of the cell.
+     */
+    i32 getGeneration(u64 index) const;
+
+    /**
+     * @brief Get the traits of a cell.
+     * @param index = The index of the record.
+     * @return The traits of the cell.
+     */
+    Traits getTraits(u64 index) const;
+
+    /**
+     * @brief Get the genome weights of a cell, they point straight into the mapped file.
+     * @param index = The index of the record.
+     * @return A pointer to the weights of the cell.
+     */
+    const r32* getWeights(u64 index) const;
+
+private:
+
+    /**
+     * @brief The mapped file.
+     */
+    MappedFile m_file;
+
+    /**
+     * @brief The number of records in the file.
+     */
+    u64 m_entityCount = 0;
+
+    /**
+     * @brief The size of each record.
+     */
+    u32 m_recordSize = 0;
+
+    /**
+     * @brief Get the start of a record.
+     * @param index = The index of the record.
+     * @return A pointer to the record.
+     */
+    const char* getRecord(u64 index) const;
+};
+
+#endif // POPULATION_H_INCLUDE
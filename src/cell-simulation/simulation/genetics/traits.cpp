@@ -6,14 +6,27 @@
 #include <stdlib.h>
 
 Traits::Traits() :
-    mutationRate(RandomGen::randomInt(0, 10000)),
-    splitRate(RandomGen::randomFloat(10.0f, 60.0f)),
-    red(RandomGen::randomFloat(0.0f, 1.0f)),
-    green(RandomGen::randomFloat(0.0f, 1.0f)),
-    blue(RandomGen::randomFloat(0.0f, 1.0f)),
-    eyeOffsetA(RandomGen::randomFloat(0.0f, PiOver2)),
-    eyeOffsetB(RandomGen::randomFloat(0.0f, PiOver2)),
-    eyeLengthA(RandomGen::randomFloat(minEyeLength, maxEyeLength)),
-    eyeLengthB(RandomGen::randomFloat(minEyeLength, maxEyeLength)),
-    eyeLengthC(RandomGen::randomFloat(minEyeLength, maxEyeLength))
+    mutationRate(0),
+    splitRate(0.0f),
+    red(0.0f),
+    green(0.0f),
+    blue(0.0f),
+    eyeOffsetA(0.0f),
+    eyeOffsetB(0.0f),
+    eyeLengthA(0.0f),
+    eyeLengthB(0.0f),
+    eyeLengthC(0.0f)
+{ }
+
+Traits::Traits(RandomGen& random) :
+    mutationRate(random.randomInt(0, 10000)),
+    splitRate(random.randomFloat(10.0f, 60.0f)),
+    red(random.randomFloat(0.0f, 1.0f)),
+    green(random.randomFloat(0.0f, 1.0f)),
+    blue(random.randomFloat(0.0f, 1.0f)),
+    eyeOffsetA(random.randomFloat(0.0f, PiOver2)),
+    eyeOffsetB(random.randomFloat(0.0f, PiOver2)),
+    eyeLengthA(random.randomFloat(minEyeLength, maxEyeLength)),
+    eyeLengthB(random.randomFloat(minEyeLength, maxEyeLength)),
+    eyeLengthC(random.randomFloat(minEyeLength, maxEyeLength))
 { }
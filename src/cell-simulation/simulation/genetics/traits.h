@@ -3,13 +3,24 @@
 
 #include <scl/types.h>
 
+class RandomGen;
+
 const r32 minEyeLength = 48.0f;
 const r32 maxEyeLength = 128.0f;
 
 struct Traits
 {
+    /**
+     * @brief Create traits with every value zeroed, used when they are about to be filled in.
+     */
     Traits();
 
+    /**
+     * @brief Create a random set of traits.
+     * @param random = The random stream to draw from.
+     */
+    explicit Traits(RandomGen& random);
+
     i32 mutationRate;
 
     r32 splitRate;
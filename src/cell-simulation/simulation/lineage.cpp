@@ -0,0 +1,213 @@
+#include "lineage.h"
+#include "eventstream.h"
+
+#include <util/log.h>
+
+// Standard includes.
+#include <algorithm>
+#include <fstream>
+
+/**
+ * @brief Orders the cells by id.
+ */
+static bool compareNodes(const LineageNode& a, const LineageNode& b)
+{
+    return a.id < b.id;
+}
+
+Lineage::Lineage() :
+    m_compactSize(LINEAGE_MIN_COMPACT_SIZE),
+    m_prunedCount(0)
+{ }
+
+void Lineage::compact()
+{
+    // The ids are handed out in order so this only sorts if a restored world reused an id.
+    if (!std::is_sorted(m_nodes.begin(), m_nodes.end(), compareNodes))
+        std::stable_sort(m_nodes.begin(), m_nodes.end(), compareNodes);
+
+    const u32 count = (u32)m_nodes.size();
+
+    for (const LineageDeath& death : m_deaths) {
+        const u32 node = find(death.id);
+        if (node < count)
+            m_nodes[node].deathTick = death.tick;
+    }
+
+    m_deaths.clear();
+
+    // A parent is always born before its children, so it comes first in the array.
+    std::vector<u32> parentIndex(count);
+    std::vector<u32> keptChildren(count, 0);
+
+    for (u32 i = 0; i < count; i++)
+        parentIndex[i] = (m_nodes[i].parent == NO_ENTITY) ? count : find(m_nodes[i].parent);
+
+    // Walk up from the youngest cells, a cell is kept if it is alive or any of its children were kept.
+    for (u32 i = count; i-- > 0; ) {
+        const bool kept = m_nodes[i].deathTick == LINEAGE_ALIVE || keptChildren[i] > 0;
+        if (kept && parentIndex[i] < count)
+            keptChildren[parentIndex[i]]++;
+    }
+
+    // The id the children of each cell point to, a spliced out cell hands its children to its own parent.
+    std::vector<u32> ancestor(count, NO_ENTITY);
+
+    u32 kept = 0;
+
+    for (u32 i = 0; i < count; i++) {
+
+        const LineageNode node = m_nodes[i];
+        const bool alive = node.deathTick == LINEAGE_ALIVE;
+        const u32 parent = (parentIndex[i] < count) ? ancestor[parentIndex[i]] : NO_ENTITY;
+
+        if (!alive && keptChildren[i] == 0)
+            continue;
+
+        if (!alive && keptChildren[i] == 1) {
+            ancestor[i] = parent;
+            continue;
+        }
+
+        ancestor[i] = node.id;
+
+        m_nodes[kept] = node;
+        m_nodes[kept].parent = parent;
+        kept++;
+    }
+
+    m_prunedCount += count - kept;
+
+    m_nodes.resize(kept);
+    m_nodes.shrink_to_fit();
+    m_deaths.shrink_to_fit();
+
+    m_compactSize = std::max<u64>(LINEAGE_MIN_COMPACT_SIZE, (u64)kept * 2);
+}
+
+void Lineage::clear()
+{
+    m_nodes.clear();
+    m_deaths.clear();
+    m_compactSize = LINEAGE_MIN_COMPACT_SIZE;
+    m_prunedCount = 0;
+}
+
+bool Lineage::writeNewick(const std::string& filePath)
+{
+    compact();
+
+    const u32 count = (u32)m_nodes.size();
+
+    // Lay the children of each cell out one after another, in id order.
+    std::vector<u32> childStart(count + 1, 0);
+    std::vector<u32> parentIndex(count);
+
+    for (u32 i = 0; i < count; i++) {
+        parentIndex[i] = (m_nodes[i].parent == NO_ENTITY) ? count : find(m_nodes[i].parent);
+        if (parentIndex[i] < count)
+            childStart[parentIndex[i] + 1]++;
+    }
+
+    for (u32 i = 0; i < count; i++)
+        childStart[i + 1] += childStart[i];
+
+    std::vector<u32> children(childStart[count]);
+    std::vector<u32> filled(childStart.begin(), childStart.end() - 1);
+
+    for (u32 i = 0; i < count; i++) {
+        if (parentIndex[i] < count)
+            children[filled[parentIndex[i]]++] = i;
+    }
+
+    std::ofstream out(filePath.c_str(), std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        Log::error("failed to write the lineage: ", filePath);
+        return false;
+    }
+
+    // The trees are written without recursion since a line of living cells can be very deep.
+    struct Frame
+    {
+        u32 node;
+        u32 next;
+    };
+
+    std::vector<Frame> stack;
+    u32 trees = 0;
+
+    for (u32 root = 0; root < count; root++) {
+
+        if (parentIndex[root] < count)
+            continue;
+
+        const Frame rootFrame = { root, childStart[root] };
+        stack.push_back(rootFrame);
+
+        if (childStart[root] != childStart[root + 1])
+            out << '(';
+
+        while (!stack.empty()) {
+
+            Frame& frame = stack.back();
+            const u32 node = frame.node;
+
+            if (frame.next < childStart[node + 1]) {
+
+                if (frame.next != childStart[node])
+                    out << ',';
+
+                const u32 child = children[frame.next++];
+
+                const Frame childFrame = { child, childStart[child] };
+                stack.push_back(childFrame);
+
+                if (childStart[child] != childStart[child + 1])
+                    out << '(';
+
+                continue;
+            }
+
+            if (childStart[node] != childStart[node + 1])
+                out << ')';
+
+            const LineageNode& cell = m_nodes[node];
+
+            out << std::dec << cell.id;
+            if (parentIndex[node] < count)
+                out << ':' << (cell.birthTick - m_nodes[parentIndex[node]].birthTick);
+
+            out << "[&&NHX:birth=" << cell.birthTick;
+            if (cell.deathTick != LINEAGE_ALIVE)
+                out << ":death=" << cell.deathTick;
+            out << ":genome=" << std::hex << cell.genomeHash << ']';
+
+            stack.pop_back();
+        }
+
+        out << ";\n";
+        trees++;
+    }
+
+    out.close();
+
+    if (out.fail()) {
+        Log::error("failed to write the lineage: ", filePath);
+        return false;
+    }
+
+    Log::info("wrote the lineage of ", count, " cells in ", trees, " trees, ", m_prunedCount, " extinct cells were pruned");
+
+    return true;
+}
+
+u32 Lineage::find(u32 id) const
+{
+    const LineageNode key = { id, 0, 0, 0, 0 };
+
+    std::vector<LineageNode>::const_iterator it = std::lower_bound(m_nodes.begin(), m_nodes.end(), key, compareNodes);
+    if (it == m_nodes.end() || it->id != id)
+        return (u32)m_nodes.size();
+
+    return (u32)(it - m_nodes.begin());
+}
@@ -0,0 +1,177 @@
+#ifndef LINEAGE_H_INCLUDE
+#define LINEAGE_H_INCLUDE
+
+// Standard includes.
+#include <string>
+#include <vector>
+
+#include <scl/types.h>
+
+/**
+ * @brief Where the family tree of the living cells is written, in the Newick format.
+ */
+const std::string LINEAGE_FILE_PATH = "../../data/lineage.nwk";
+
+/**
+ * @brief The death tick of a cell that is still alive.
+ */
+const u64 LINEAGE_ALIVE = 0xffffffffffffffffULL;
+
+/**
+ * @brief The fewest records the lineage holds before it prunes the extinct branches.
+ */
+const u32 LINEAGE_MIN_COMPACT_SIZE = 4096;
+
+/**
+ * @brief One cell in the family tree.
+ */
+struct LineageNode
+{
+    /**
+     * @brief The unique id of the cell.
+     */
+    u32 id;
+
+    /**
+     * @brief The id of the closest ancestor still in the tree, NO_ENTITY for the root of a tree.
+     */
+    u32 parent;
+
+    /**
+     * @brief The tick the cell was born on.
+     */
+    u64 birthTick;
+
+    /**
+     * @brief The tick the cell died on, LINEAGE_ALIVE while it is alive.
+     */
+    u64 deathTick;
+
+    /**
+     * @brief The hash of the genome the cell was born with.
+     */
+    u64 genomeHash;
+};
+
+/**
+ * @brief A death waiting to be applied to the family tree.
+ */
+struct LineageDeath
+{
+    u32 id;
+    u32 reserved;
+    u64 tick;
+};
+
+/**
+ * @brief Tracks the ancestry of the cells as parent pointers keyed by the entity id.
+ *
+ * Births and deaths are only appended to two arrays, the ids only ever grow so the births stay
+ * sorted by id and a cell is found with a binary search. Once the arrays have doubled in size since
+ * the last time, the deaths are applied and the tree is pruned down to the ancestry of the living
+ * cells: dead cells with no living descendants are dropped and dead cells with a single surviving
+ * line are spliced out, so only the points where the living lines coalesce are kept. The tree then
+ * holds less than two records per living cell no matter how many cells were ever born.
+ */
+class Lineage
+{
+public:
+    friend class Snapshot;
+
+    /**
+     * @brief Create an empty lineage.
+     */
+    Lineage();
+
+    /**
+     * @brief Record a cell being born.
+     * @param tick = The current tick.
+     * @param id = The id of the new cell.
+     * @param parent = The id of the cell it split from, NO_ENTITY if it didn't.
+     * @param genomeHash = The hash of its genome.
+     */
+    void birth(u64 tick, u32 id, u32 parent, u64 genomeHash)
+    {
+        const LineageNode node = { id, parent, tick, LINEAGE_ALIVE, genomeHash };
+        m_nodes.push_back(node);
+    }
+
+    /**
+     * @brief Record a cell dying.
+     * @param tick = The current tick.
+     * @param id = The id of the cell.
+     */
+    void death(u64 tick, u32 id)
+    {
+        const LineageDeath death = { id, 0, tick };
+        m_deaths.push_back(death);
+    }
+
+    /**
+     * @brief Check if enough has been recorded since the last prune to prune again.
+     * @return True if compact() should be called.
+     */
+    bool needsCompaction() const { return m_nodes.size() >= m_compactSize || m_deaths.size() >= m_compactSize; }
+
+    /**
+     * @brief Apply the recorded deaths and prune the tree down to the ancestry of the living cells.
+     */
+    void compact();
+
+    /**
+     * @brief Forget every cell.
+     */
+    void clear();
+
+    /**
+     * @brief Prune the tree and write it to a file, one Newick tree per line for each group of related living cells.
+     * Every node is labeled with its id, the branch lengths are in ticks between births and the
+     * birth tick, death tick and genome hash are added as NHX comments.
+     * @param filePath = The path of the file.
+     * @return True if sucessful.
+     */
+    bool writeNewick(const std::string& filePath);
+
+    /**
+     * @brief Get the number of cells in the tree, including the births since the last prune.
+     * @return The node count.
+     */
+    u32 getNodeCount() const { return (u32)m_nodes.size(); }
+
+    /**
+     * @brief Get the number of cells pruned from the tree so far.
+     * @return The pruned node count.
+     */
+    u64 getPrunedCount() const { return m_prunedCount; }
+
+private:
+
+    /**
+     * @brief Find a cell in the tree.
+     * @param id = The id of the cell.
+     * @return The index of the cell, m_nodes.size() if it isn't in the tree.
+     */
+    u32 find(u32 id) const;
+
+    /**
+     * @brief The cells in the tree, sorted by id.
+     */
+    std::vector<LineageNode> m_nodes;
+
+    /**
+     * @brief The deaths since the last prune.
+     */
+    std::vector<LineageDeath> m_deaths;
+
+    /**
+     * @brief The size either array has to reach before the next prune.
+     */
+    u64 m_compactSize;
+
+    /**
+     * @brief The number of cells pruned from the tree so far.
+     */
+    u64 m_prunedCount;
+};
+
+#endif // LINEAGE_H_INCLUDE
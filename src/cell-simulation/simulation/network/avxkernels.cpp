@@ -0,0 +1,132 @@
+#include "kernels.h"
+
+#ifdef NETWORK_KERNELS_X86
+
+// Standard includes.
+#include <immintrin.h>
+
+// This file is compiled with AVX2 and FMA enabled, nothing in here may run
+// before detectKernel has confirmed the cpu supports them.
+
+/**
+ * @brief Eight wide version of fastTanh.
+ */
+static inline __m256 fastTanh8(__m256 x)
+{
+    const __m256 limit = _mm256_set1_ps(FAST_TANH_LIMIT);
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    x = _mm256_max_ps(_mm256_min_ps(x, limit), _mm256_sub_ps(_mm256_setzero_ps(), limit));
+
+    const __m256 x2 = _mm256_mul_ps(x, x);
+
+    __m256 p = _mm256_add_ps(_mm256_set1_ps(378.0f), x2);
+    p = _mm256_fmadd_ps(x2, p, _mm256_set1_ps(17325.0f));
+    p = _mm256_fmadd_ps(x2, p, _mm256_set1_ps(135135.0f));
+    p = _mm256_mul_ps(x, p);
+
+    __m256 q = _mm256_fmadd_ps(x2, _mm256_set1_ps(28.0f), _mm256_set1_ps(3150.0f));
+    q = _mm256_fmadd_ps(x2, q, _mm256_set1_ps(62370.0f));
+    q = _mm256_fmadd_ps(x2, q, _mm256_set1_ps(135135.0f));
+
+    const __m256 result = _mm256_div_ps(p, q);
+
+    return _mm256_max_ps(_mm256_min_ps(result, one), _mm256_sub_ps(_mm256_setzero_ps(), one));
+}
+
+/**
+ * @brief Four wide version of fastTanh, used for the outputs.
+ */
+static inline __m128 fastTanh4(__m128 x)
+{
+    const __m128 limit = _mm_set1_ps(FAST_TANH_LIMIT);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    x = _mm_max_ps(_mm_min_ps(x, limit), _mm_sub_ps(_mm_setzero_ps(), limit));
+
+    const __m128 x2 = _mm_mul_ps(x, x);
+
+    __m128 p = _mm_add_ps(_mm_set1_ps(378.0f), x2);
+    p = _mm_fmadd_ps(x2, p, _mm_set1_ps(17325.0f));
+    p = _mm_fmadd_ps(x2, p, _mm_set1_ps(135135.0f));
+    p = _mm_mul_ps(x, p);
+
+    __m128 q = _mm_fmadd_ps(x2, _mm_set1_ps(28.0f), _mm_set1_ps(3150.0f));
+    q = _mm_fmadd_ps(x2, q, _mm_set1_ps(62370.0f));
+    q = _mm_fmadd_ps(x2, q, _mm_set1_ps(135135.0f));
+
+    const __m128 result = _mm_div_ps(p, q);
+
+    return _mm_max_ps(_mm_min_ps(result, one), _mm_sub_ps(_mm_setzero_ps(), one));
+}
+
+void computeBatchAVX2(const NetworkShape& shape, const r32* const* weights,
+                      const r32* inputs, r32* outputs, u32 count)
+{
+    const u32 inputCount = shape.inputCount;
+    const u32 hiddenCount = shape.hiddenCount;
+    const u32 outputCount = shape.outputCount;
+
+    alignas(32) r32 hidden[NETWORK_MAX_HIDDEN];
+
+    for (u32 n = 0; n < count; ++n) {
+
+        const r32* inputWeights = weights[n];
+        const r32* inputBiases = inputWeights + (inputCount * hiddenCount);
+        const r32* outputWeights = inputBiases + hiddenCount;
+        const r32* outputBiases = outputWeights + (hiddenCount * outputCount);
+
+        const r32* x = inputs + (n * inputCount);
+        r32* y = outputs + (n * outputCount);
+
+        // Keep eight hidden sums in a register while walking down the input rows.
+        u32 j = 0;
+        for (; j + 8 <= hiddenCount; j += 8) {
+
+            __m256 sum = _mm256_loadu_ps(inputBiases + j);
+
+            for (u32 i = 0; i < inputCount; ++i) {
+                const __m256 row = _mm256_loadu_ps(inputWeights + (i * hiddenCount) + j);
+                sum = _mm256_fmadd_ps(_mm256_set1_ps(x[i]), row, sum);
+            }
+
+            _mm256_store_ps(hidden + j, fastTanh8(sum));
+        }
+
+        for (; j < hiddenCount; ++j) {
+
+            r32 sum = inputBiases[j];
+
+            for (u32 i = 0; i < inputCount; ++i)
+                sum += x[i] * inputWeights[(i * hiddenCount) + j];
+
+            hidden[j] = fastTanh(sum);
+        }
+
+        // There are only a handful of outputs, four wide vectors fit them better.
+        u32 k = 0;
+        for (; k + 4 <= outputCount; k += 4) {
+
+            __m128 sum = _mm_loadu_ps(outputBiases + k);
+
+            for (u32 h = 0; h < hiddenCount; ++h) {
+                const __m128 row = _mm_loadu_ps(outputWeights + (h * outputCount) + k);
+                sum = _mm_fmadd_ps(_mm_set1_ps(hidden[h]), row, sum);
+            }
+
+            _mm_storeu_ps(y + k, fastTanh4(sum));
+        }
+
+        for (; k < outputCount; ++k) {
+
+            r32 sum = outputBiases[k];
+
+            for (u32 h = 0; h < hiddenCount; ++h)
+                sum += hidden[h] * outputWeights[(h * outputCount) + k];
+
+            y[k] = fastTanh(sum);
+        }
+    }
+}
+
+#endif // NETWORK_KERNELS_X86
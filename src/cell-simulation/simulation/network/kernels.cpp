@@ -0,0 +1,162 @@
+#include "kernels.h"
+
+// Standard includes.
+#include <cmath>
+
+// Project includes.
+#include "../neuralnetwork.h"
+
+void computeBatchScalar(const NetworkShape& shape, const r32* const* weights,
+                        const r32* inputs, r32* outputs, u32 count)
+{
+    const u32 inputCount = shape.inputCount;
+    const u32 hiddenCount = shape.hiddenCount;
+    const u32 outputCount = shape.outputCount;
+
+    r32 hidden[NETWORK_MAX_HIDDEN];
+
+    for (u32 n = 0; n < count; ++n) {
+
+        const r32* inputWeights = weights[n];
+        const r32* inputBiases = inputWeights + (inputCount * hiddenCount);
+        const r32* outputWeights = inputBiases + hiddenCount;
+        const r32* outputBiases = outputWeights + (hiddenCount * outputCount);
+
+        const r32* x = inputs + (n * inputCount);
+        r32* y = outputs + (n * outputCount);
+
+        // Start from the biases and accumulate one input row at a time.
+        for (u32 j = 0; j < hiddenCount; ++j)
+            hidden[j] = inputBiases[j];
+
+        for (u32 i = 0; i < inputCount; ++i) {
+
+            const r32* row = inputWeights + (i * hiddenCount);
+
+            for (u32 j = 0; j < hiddenCount; ++j)
+                hidden[j] += x[i] * row[j];
+        }
+
+        for (u32 j = 0; j < hiddenCount; ++j)
+            hidden[j] = NeuralNetwork::HyperTanFunction(hidden[j]);
+
+        // Compute hidden-to-output weighted sums.
+        for (u32 k = 0; k < outputCount; ++k)
+            y[k] = outputBiases[k];
+
+        for (u32 j = 0; j < hiddenCount; ++j) {
+
+            const r32* row = outputWeights + (j * outputCount);
+
+            for (u32 k = 0; k < outputCount; ++k)
+                y[k] += hidden[j] * row[k];
+        }
+
+        for (u32 k = 0; k < outputCount; ++k)
+            y[k] = NeuralNetwork::HyperTanFunction(y[k]);
+    }
+}
+
+bool isKernelSupported(NetworkKernel kernel)
+{
+    switch (kernel) {
+
+    case NetworkKernel::Scalar:
+        return true;
+
+#ifdef NETWORK_KERNELS_X86
+#if defined(__GNUC__) || defined(__clang__)
+    case NetworkKernel::SSE:
+        return __builtin_cpu_supports("sse2");
+
+    case NetworkKernel::AVX2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+    // SSE2 is part of the x64 baseline, we have no portable way to check for AVX2 here.
+    case NetworkKernel::SSE:
+        return true;
+#endif
+#endif
+
+#ifdef NETWORK_KERNELS_NEON
+    // NEON was enabled at compile time so every cpu we can run on has it.
+    case NetworkKernel::NEON:
+        return true;
+#endif
+
+    default:
+        return false;
+    }
+}
+
+NetworkKernel detectKernel()
+{
+    const NetworkKernel preferred[] = {
+        NetworkKernel::AVX2,
+        NetworkKernel::NEON,
+        NetworkKernel::SSE
+    };
+
+    for (auto& kernel : preferred) {
+        if (isKernelSupported(kernel))
+            return kernel;
+    }
+
+    return NetworkKernel::Scalar;
+}
+
+NetworkBatchFunction getKernelFunction(NetworkKernel kernel)
+{
+    switch (kernel) {
+
+#ifdef NETWORK_KERNELS_X86
+    case NetworkKernel::SSE:
+        return computeBatchSSE;
+
+    case NetworkKernel::AVX2:
+        return computeBatchAVX2;
+#endif
+
+#ifdef NETWORK_KERNELS_NEON
+    case NetworkKernel::NEON:
+        return computeBatchNEON;
+#endif
+
+    default:
+        return computeBatchScalar;
+    }
+}
+
+const char* getKernelName(NetworkKernel kernel)
+{
+    switch (kernel) {
+    case NetworkKernel::SSE: return "sse";
+    case NetworkKernel::AVX2: return "avx2";
+    case NetworkKernel::NEON: return "neon";
+    default: return "scalar";
+    }
+}
+
+bool findKernel(const std::string& name, NetworkKernel& kernel)
+{
+    if (name == "auto") {
+        kernel = detectKernel();
+        return true;
+    }
+
+    const NetworkKernel kernels[] = {
+        NetworkKernel::Scalar,
+        NetworkKernel::SSE,
+        NetworkKernel::AVX2,
+        NetworkKernel::NEON
+    };
+
+    for (auto& candidate : kernels) {
+        if (name == getKernelName(candidate)) {
+            kernel = candidate;
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,142 @@
+#ifndef KERNELS_H_INCLUDE
+#define KERNELS_H_INCLUDE
+
+#include <string>
+
+#include <scl/types.h>
+
+/**
+ * @brief The largest hidden layer supported, the hidden values are kept on the stack.
+ */
+const u32 NETWORK_MAX_HIDDEN = 64;
+
+/**
+ * @brief The instruction sets the forward pass can be evaluated with.
+ * The kernels round differently, the AVX2 kernel fuses its multiply adds and the vector kernels
+ * use an approximate tanh, so the same seed only gives the same run on the same kernel.
+ */
+enum class NetworkKernel : u8
+{
+    Scalar,
+    SSE,
+    AVX2,
+    NEON
+};
+
+/**
+ * @brief The shape of the network the kernels are evaluating.
+ */
+struct NetworkShape
+{
+    u32 inputCount;
+    u32 hiddenCount;
+    u32 outputCount;
+};
+
+/**
+ * @brief Evaluates a batch of networks that share a shape.
+ * @param shape = The shape of the networks.
+ * @param weights = A weight pointer for each network in the batch.
+ * @param inputs = The packed input values, inputCount values per network.
+ * @param outputs = The packed output buffer, outputCount values per network.
+ * @param count = The number of networks in the batch.
+ */
+typedef void (*NetworkBatchFunction)(const NetworkShape& shape, const r32* const* weights,
+                                     const r32* inputs, r32* outputs, u32 count);
+
+/**
+ * @brief The weights are stored in the same layout by every kernel, for each input a row of hidden
+ * weights, then the hidden biases, for each hidden node a row of output weights and then the output biases.
+ * Keeping the rows contiguous lets the kernels broadcast one input and multiply a full row of weights at a time.
+ */
+
+/**
+ * @brief The largest absolute value passed to the tanh approximation, beyond this it is within 1e-4 of +-1.
+ */
+const r32 FAST_TANH_LIMIT = 4.97f;
+
+/**
+ * @brief Approximate tanh with a [7/6] pade approximant, the error is below 1e-4 over the whole range.
+ * @param x = The input value.
+ * @return The approximated hyperbolic tangent of the value.
+ */
+inline r32 fastTanh(r32 x)
+{
+    x = (x < -FAST_TANH_LIMIT) ? -FAST_TANH_LIMIT : ((x > FAST_TANH_LIMIT) ? FAST_TANH_LIMIT : x);
+
+    const r32 x2 = x * x;
+    const r32 p = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+    const r32 q = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+    const r32 result = p / q;
+
+    return (result < -1.0f) ? -1.0f : ((result > 1.0f) ? 1.0f : result);
+}
+
+/**
+ * @brief The reference forward pass, plain loops and the exact tanh.
+ */
+void computeBatchScalar(const NetworkShape& shape, const r32* const* weights,
+                        const r32* inputs, r32* outputs, u32 count);
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define NETWORK_KERNELS_X86
+
+/**
+ * @brief The forward pass using four wide SSE vectors.
+ */
+void computeBatchSSE(const NetworkShape& shape, const r32* const* weights,
+                     const r32* inputs, r32* outputs, u32 count);
+
+/**
+ * @brief The forward pass using eight wide AVX2 vectors and fused multiply adds.
+ */
+void computeBatchAVX2(const NetworkShape& shape, const r32* const* weights,
+                      const r32* inputs, r32* outputs, u32 count);
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define NETWORK_KERNELS_NEON
+
+/**
+ * @brief The forward pass using four wide NEON vectors.
+ */
+void computeBatchNEON(const NetworkShape& shape, const r32* const* weights,
+                      const r32* inputs, r32* outputs, u32 count);
+#endif
+
+/**
+ * @brief Check if the cpu we are running on supports a kernel.
+ * @param kernel = The kernel to check.
+ * @return True if the kernel can be used.
+ */
+bool isKernelSupported(NetworkKernel kernel);
+
+/**
+ * @brief Find the fastest kernel the cpu we are running on supports.
+ * @return The best supported kernel.
+ */
+NetworkKernel detectKernel();
+
+/**
+ * @brief Get the function that evaluates a kernel.
+ * @param kernel = The kernel to get the function for, it must be supported.
+ * @return The batch function of the kernel.
+ */
+NetworkBatchFunction getKernelFunction(NetworkKernel kernel);
+
+/**
+ * @brief Get the display name of a kernel.
+ * @param kernel = The kernel to get the name of.
+ * @return The name of the kernel.
+ */
+const char* getKernelName(NetworkKernel kernel);
+
+/**
+ * @brief Find a kernel by its display name.
+ * @param name = The name of the kernel, "auto" picks the fastest supported one.
+ * @param kernel = Set to the kernel with the name.
+ * @return True if the name is known.
+ */
+bool findKernel(const std::string& name, NetworkKernel& kernel);
+
+#endif // KERNELS_H_INCLUDE
@@ -0,0 +1,107 @@
+#include "kernels.h"
+
+#ifdef NETWORK_KERNELS_NEON
+
+// Standard includes.
+#include <arm_neon.h>
+
+/**
+ * @brief Four wide version of fastTanh.
+ */
+static inline float32x4_t fastTanh4(float32x4_t x)
+{
+    const float32x4_t limit = vdupq_n_f32(FAST_TANH_LIMIT);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+
+    x = vmaxq_f32(vminq_f32(x, limit), vnegq_f32(limit));
+
+    const float32x4_t x2 = vmulq_f32(x, x);
+
+    float32x4_t p = vaddq_f32(vdupq_n_f32(378.0f), x2);
+    p = vmlaq_f32(vdupq_n_f32(17325.0f), x2, p);
+    p = vmlaq_f32(vdupq_n_f32(135135.0f), x2, p);
+    p = vmulq_f32(x, p);
+
+    float32x4_t q = vmlaq_f32(vdupq_n_f32(3150.0f), x2, vdupq_n_f32(28.0f));
+    q = vmlaq_f32(vdupq_n_f32(62370.0f), x2, q);
+    q = vmlaq_f32(vdupq_n_f32(135135.0f), x2, q);
+
+#if defined(__aarch64__)
+    const float32x4_t result = vdivq_f32(p, q);
+#else
+    // No vector divide on 32 bit arm, refine the reciprocal estimate twice instead.
+    float32x4_t reciprocal = vrecpeq_f32(q);
+    reciprocal = vmulq_f32(vrecpsq_f32(q, reciprocal), reciprocal);
+    reciprocal = vmulq_f32(vrecpsq_f32(q, reciprocal), reciprocal);
+    const float32x4_t result = vmulq_f32(p, reciprocal);
+#endif
+
+    return vmaxq_f32(vminq_f32(result, one), vnegq_f32(one));
+}
+
+void computeBatchNEON(const NetworkShape& shape, const r32* const* weights,
+                      const r32* inputs, r32* outputs, u32 count)
+{
+    const u32 inputCount = shape.inputCount;
+    const u32 hiddenCount = shape.hiddenCount;
+    const u32 outputCount = shape.outputCount;
+
+    alignas(16) r32 hidden[NETWORK_MAX_HIDDEN];
+
+    for (u32 n = 0; n < count; ++n) {
+
+        const r32* inputWeights = weights[n];
+        const r32* inputBiases = inputWeights + (inputCount * hiddenCount);
+        const r32* outputWeights = inputBiases + hiddenCount;
+        const r32* outputBiases = outputWeights + (hiddenCount * outputCount);
+
+        const r32* x = inputs + (n * inputCount);
+        r32* y = outputs + (n * outputCount);
+
+        // Keep four hidden sums in a register while walking down the input rows.
+        u32 j = 0;
+        for (; j + 4 <= hiddenCount; j += 4) {
+
+            float32x4_t sum = vld1q_f32(inputBiases + j);
+
+            for (u32 i = 0; i < inputCount; ++i)
+                sum = vmlaq_n_f32(sum, vld1q_f32(inputWeights + (i * hiddenCount) + j), x[i]);
+
+            vst1q_f32(hidden + j, fastTanh4(sum));
+        }
+
+        for (; j < hiddenCount; ++j) {
+
+            r32 sum = inputBiases[j];
+
+            for (u32 i = 0; i < inputCount; ++i)
+                sum += x[i] * inputWeights[(i * hiddenCount) + j];
+
+            hidden[j] = fastTanh(sum);
+        }
+
+        // The same again for the outputs, walking down the hidden rows.
+        u32 k = 0;
+        for (; k + 4 <= outputCount; k += 4) {
+
+            float32x4_t sum = vld1q_f32(outputBiases + k);
+
+            for (u32 h = 0; h < hiddenCount; ++h)
+                sum = vmlaq_n_f32(sum, vld1q_f32(outputWeights + (h * outputCount) + k), hidden[h]);
+
+            vst1q_f32(y + k, fastTanh4(sum));
+        }
+
+        for (; k < outputCount; ++k) {
+
+            r32 sum = outputBiases[k];
+
+            for (u32 h = 0; h < hiddenCount; ++h)
+                sum += hidden[h] * outputWeights[(h * outputCount) + k];
+
+            y[k] = fastTanh(sum);
+        }
+    }
+}
+
+#endif // NETWORK_KERNELS_NEON
@@ -7,8 +7,13 @@
 
 #include <scl/types.h>
 
+// Project includes.
+#include "network/kernels.h"
+
 /**
  * @brief This class is used to calculate the output data of the cell.
+ * The network only describes the topology, the weights are owned by the genomes.
+ * The forward pass runs on the fastest kernel the cpu supports unless another one is selected.
  */
 class NeuralNetwork
 {
@@ -22,11 +27,6 @@ public:
      */
     NeuralNetwork(u32 input, u32 hidden, u32 output);
 
-    /**
-     * @brief Default NeuralNetwork Destructor.
-     */
-    ~NeuralNetwork();
-
     /**
      * @brief Get the number of inputs in the network.
      * @return The number of inputs.
@@ -54,29 +54,42 @@ public:
     }
 
     /**
-     * @brief Get the number of outputs needed for this network.
-     * @return The number of network outputs.
+     * @brief Get the kernel the forward pass is evaluated with.
+     * @return The current kernel.
      */
-    const r32* getOutputs() const { return m_outputs; }
+    NetworkKernel getKernel() const { return m_kernel; }
 
     /**
-     * @brief Set the weight data used for processing the input values.
-     * @param weights = A pointer to the weight data.
+     * @brief Select the kernel the forward pass is evaluated with.
+     * @param kernel = The kernel to use, NetworkKernel::Scalar is the exact reference path.
+     * @return True if the kernel is supported and was selected.
      */
-    void setWeights(const r32 *weights);
+    bool setKernel(NetworkKernel kernel);
 
     /**
-     * @brief Compute the output values of the network based on the input values.
-     * @param xValues = The input values.
+     * @brief Compute the output values of a single network.
+     * @param weights = The weight data of the network, laid out the same way as the genome.
+     * @param inputs = The input values.
+     * @param outputs = The buffer to write the output values to.
      */
-    void computeOutputs(r32* xValues);
+    void computeOutputs(const r32* weights, const r32* inputs, r32* outputs) const;
+
+    /**
+     * @brief Compute the output values of a batch of networks that share this topology.
+     * The weights are read straight from the genomes so nothing is copied per network.
+     * @param weights = A weight pointer for each network in the batch.
+     * @param inputs = The packed input values, getInputCount() values per network.
+     * @param outputs = The packed output buffer, getOutputCount() values per network.
+     * @param count = The number of networks in the batch.
+     */
+    void computeBatch(const r32* const* weights, const r32* inputs, r32* outputs, u32 count) const;
 
     /**
      * @brief One of the functions that can be used to process data in the nerual network.
      * @param x = The input value.
      * @return = The calculated output value.
      */
-    inline r32 StepFunction(r32 x)
+    inline static r32 StepFunction(r32 x)
     {
         if (x > 0.0f)
             return 1.0f;
@@ -89,7 +102,7 @@ public:
      * @param x = The input value.
      * @return = The calculated output value.
      */
-    inline r32 SigmoidFunction(r32 x)
+    inline static r32 SigmoidFunction(r32 x)
     {
         if (x < -45.0f)
             return 0.0f;
@@ -104,7 +117,7 @@ public:
      * @param x = The input value.
      * @return = The calculated output value.
      */
-    inline r32 HyperTanFunction(r32 x)
+    inline static r32 HyperTanFunction(r32 x)
     {
         if (x < -10.0f)
             return -1.0f;
@@ -132,50 +145,14 @@ private:
     const u32 m_outputCount;
 
     /**
-     * @brief Used to processes the input data.
+     * @brief The kernel the forward pass is evaluated with.
      */
-    r32* m_inputs;
+    NetworkKernel m_kernel;
 
     /**
-     * @brief Used for network processing.
+     * @brief The batch function of the selected kernel.
      */
-    r32** m_inputWeights;
-
-    /**
-     * @brief Used to sum the input values.
-     */
-    r32* m_inputSums;
-
-    /**
-     * @brief The input biases caculated from the weight data.
-     */
-    r32* m_inputBiases;
-
-    /**
-     * @brief The output buffer for this network.
-     */
-    r32* m_inputOutputs;
-
-    /**
-     * @brief The output weights caculated from the weight data.
-     */
-    r32** m_outputWeights;
-
-    /**
-     * @brief The caculated output sums of the network.
-     */
-    r32* m_outputSums;
-
-    /**
-     * @brief The output biases calculated from the weight data.
-     */
-    r32* m_outputBiases;
-
-    /**
-     * @brief The output buffer used to store the network output during processing.
-     */
-    r32* m_outputs;
-
+    NetworkBatchFunction m_batchFunction;
 };
 
 #endif // NEURALNETWORK_H_INCLUDE
@@ -0,0 +1,75 @@
+#include "spatialgrid.h"
+
+// Standard includes.
+#include <cmath>
+
+SpatialGrid::SpatialGrid(const r32 worldRadius)
+{
+    // Leave a cell of padding on each side for the entities bouncing off the edge of the world.
+    const i32 halfSize = (i32)std::ceil(worldRadius / GRID_CELL_SIZE) + 1;
+
+    m_size = halfSize * 2;
+    m_origin = -(r32)(halfSize * GRID_CELL_SIZE);
+
+    m_cellStart.resize(m_size * m_size, 0);
+    m_cellCount.resize(m_size * m_size, 0);
+}
+
+void SpatialGrid::rebuild(const std::vector<vec2f>& locations)
+{
+    const u32 entityCount = locations.size();
+
+    m_entities.resize(entityCount);
+    m_entityCell.resize(entityCount);
+
+    std::fill(m_cellCount.begin(), m_cellCount.end(), 0);
+
+    // Count the entities in each cell.
+    for (u32 i = 0; i < entityCount; i++) {
+
+        const u32 cell = (toCell(locations[i].y) * m_size) + toCell(locations[i].x);
+
+        m_entityCell[i] = cell;
+        m_cellCount[cell]++;
+    }
+
+    // The start of each cell is the sum of the counts before it.
+    u32 start = 0;
+    for (u32 cell = 0; cell < m_cellStart.size(); cell++) {
+        m_cellStart[cell] = start;
+        start += m_cellCount[cell];
+    }
+
+    // Place the entities, the count is used as the write cursor and ends up back where it started.
+    std::fill(m_cellCount.begin(), m_cellCount.end(), 0);
+
+    for (u32 i = 0; i < entityCount; i++) {
+
+        const u32 cell = m_entityCell[i];
+        m_entities[m_cellStart[cell] + m_cellCount[cell]++] = i;
+    }
+}
+
+void SpatialGrid::query(u32 index, i32 reach, std::vector<u32>& list) const
+{
+    forEachNear(index, reach, [&](u32 entity) {
+        list.push_back(entity);
+    });
+}
+
+rectf SpatialGrid::getCellBounds(i32 x, i32 y) const
+{
+    rectf bounds;
+    bounds.x = m_origin + (x * GRID_CELL_SIZE);
+    bounds.y = m_origin + (y * GRID_CELL_SIZE);
+    bounds.width = GRID_CELL_SIZE;
+    bounds.height = GRID_CELL_SIZE;
+
+    return bounds;
+}
+
+i32 SpatialGrid::toCell(r32 value) const
+{
+    const i32 cell = (i32)std::floor((value - m_origin) / GRID_CELL_SIZE);
+    return std::min(std::max(cell, 0), m_size - 1);
+}
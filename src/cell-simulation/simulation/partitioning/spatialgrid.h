@@ -0,0 +1,191 @@
+#ifndef SPATIALGRID_H_INCLUDE
+#define SPATIALGRID_H_INCLUDE
+
+// Standard includes.
+#include <algorithm>
+#include <vector>
+
+// SCL includes.
+#include <scl/types.h>
+#include <scl/math/vec2.h>
+#include <scl/math/rect.h>
+
+/**
+ * @brief The width and height of a grid cell, large enough that touching entities are never more than a cell apart.
+ */
+const i32 GRID_CELL_SIZE = 64;
+
+/**
+ * @brief This class divides the world into a dense uniform grid to speed up the neighbour queries.
+ * The grid is rebuilt from scratch every update with a counting sort, every entity is stored once
+ * in a flat array sorted by cell and each cell is a range of that array.
+ */
+class SpatialGrid
+{
+public:
+
+    /**
+     * @brief The default spatial grid constructor.
+     * @param worldRadius = The world radius, the grid covers the square around the world circle.
+     */
+    SpatialGrid(const r32 worldRadius);
+
+    /**
+     * @brief Rebuild the grid from the entity locations.
+     * The arrays only grow, once they are large enough a rebuild doesn't allocate.
+     * @param locations = The location of each entity, the grid stores the indices into this array.
+     */
+    void rebuild(const std::vector<vec2f>& locations);
+
+    /**
+     * @brief Find the entities in the block of cells around an entity.
+     * Every entity is stored once so the list never contains duplicates.
+     * @param index = The index of the entity, left out of the list.
+     * @param reach = How many cells around the cell of the entity to search, one searches the 3x3 block.
+     * @param list = The list to add the indices of the near entities to.
+     */
+    void query(u32 index, i32 reach, std::vector<u32>& list) const;
+
+    /**
+     * @brief Call a function for each entity in the block of cells around an entity.
+     * Nothing is copied or allocated, the function is handed the indices straight from the grid.
+     * @param index = The index of the entity, it is skipped.
+     * @param reach = How many cells around the cell of the entity to search, one searches the 3x3 block.
+     * @param visit = The function to call with the index of each near entity.
+     */
+    template <typename Visitor>
+    void forEachNear(u32 index, i32 reach, Visitor&& visit) const;
+
+    /**
+     * @brief Call a function for each entity stored in the cells overlapping a rectangle.
+     * Entities are stored by their center, widen the rectangle by the largest radius to catch
+     * the entities that only poke into it.
+     * @param bounds = The world space rectangle.
+     * @param visit = The function to call with the index of each entity.
+     */
+    template <typename Visitor>
+    void forEachInRect(const rectf& bounds, Visitor&& visit) const;
+
+    /**
+     * @brief Get the number of cells along each side of the grid.
+     * @return The grid size.
+     */
+    i32 getSize() const { return m_size; }
+
+    /**
+     * @brief Get the bounds of a cell, used to visualize the grid.
+     * @param x = The column of the cell.
+     * @param y = The row of the cell.
+     * @return The world space bounds of the cell.
+     */
+    rectf getCellBounds(i32 x, i32 y) const;
+
+    /**
+     * @brief Get the number of entities in a cell, used to visualize the grid.
+     * @param x = The column of the cell.
+     * @param y = The row of the cell.
+     * @return The number of entities in the cell.
+     */
+    u32 getCellEntityCount(i32 x, i32 y) const { return m_cellCount[(y * m_size) + x]; }
+
+private:
+
+    /**
+     * @brief The number of cells along each side of the grid.
+     */
+    i32 m_size;
+
+    /**
+     * @brief The world location of the corner of the first cell.
+     */
+    r32 m_origin;
+
+    /**
+     * @brief The index of the first entity of each cell in the entities array.
+     */
+    std::vector<u32> m_cellStart;
+
+    /**
+     * @brief The number of entities in each cell.
+     */
+    std::vector<u32> m_cellCount;
+
+    /**
+     * @brief The entity indices sorted by cell.
+     */
+    std::vector<u32> m_entities;
+
+    /**
+     * @brief The cell of each entity at the last rebuild.
+     */
+    std::vector<u32> m_entityCell;
+
+    /**
+     * @brief Get the column or row a world coordinate falls in, clamped to the grid.
+     * @param value = The world coordinate.
+     * @return The column or row.
+     */
+    i32 toCell(r32 value) const;
+};
+
+template <typename Visitor>
+void SpatialGrid::forEachNear(u32 index, i32 reach, Visitor&& visit) const
+{
+    if (index >= m_entityCell.size()) {
+        return;
+    }
+
+    const i32 cellX = m_entityCell[index] % m_size;
+    const i32 cellY = m_entityCell[index] / m_size;
+
+    const i32 minX = std::max(cellX - reach, 0);
+    const i32 maxX = std::min(cellX + reach, m_size - 1);
+    const i32 minY = std::max(cellY - reach, 0);
+    const i32 maxY = std::min(cellY + reach, m_size - 1);
+
+    for (i32 y = minY; y <= maxY; y++) {
+
+        // The cells of a row are next to each other in the entities array, walk them as one range.
+        const u32 first = (y * m_size) + minX;
+        const u32 last = (y * m_size) + maxX;
+
+        const u32 begin = m_cellStart[first];
+        const u32 end = m_cellStart[last] + m_cellCount[last];
+
+        for (u32 i = begin; i < end; i++) {
+
+            const u32 entity = m_entities[i];
+
+            if (entity != index)
+                visit(entity);
+        }
+    }
+}
+
+template <typename Visitor>
+void SpatialGrid::forEachInRect(const rectf& bounds, Visitor&& visit) const
+{
+    if (m_entityCell.empty()) {
+        return;
+    }
+
+    const i32 minX = toCell(bounds.x);
+    const i32 maxX = toCell(bounds.x + bounds.width);
+    const i32 minY = toCell(bounds.y);
+    const i32 maxY = toCell(bounds.y + bounds.height);
+
+    for (i32 y = minY; y <= maxY; y++) {
+
+        const u32 first = (y * m_size) + minX;
+        const u32 last = (y * m_size) + maxX;
+
+        const u32 begin = m_cellStart[first];
+        const u32 end = m_cellStart[last] + m_cellCount[last];
+
+        for (u32 i = begin; i < end; i++) {
+            visit(m_entities[i]);
+        }
+    }
+}
+
+#endif // SPATIALGRID_H_INCLUDE
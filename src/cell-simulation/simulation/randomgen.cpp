@@ -1,14 +1,42 @@
 #include "randomgen.h"
 
-std::random_device RandomGen::m_device;
-std::mt19937 RandomGen::m_engine(m_device());
+/**
+ * @brief The splitmix64 finalizer, every bit of the input affects every bit of the output.
+ */
+static inline u64 mix(u64 value)
+{
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+const u64 GOLDEN_GAMMA = 0x9e3779b97f4a7c15ULL;
+
+RandomGen::RandomGen(u64 seed, u64 entity, u64 tick, RandomPurpose purpose) :
+    m_key(mix(mix(mix(mix(seed) ^ entity) ^ tick) ^ (u64)purpose)),
+    m_counter(0)
+{ }
 
-r32 RandomGen::randomFloat(const r32 min, const r32 max) {
-    std::uniform_real_distribution<r32> dist(min, max);
-    return dist(m_engine);
+u64 RandomGen::next()
+{
+    // This is splitmix64 jumped straight to the counter, no state is carried between values.
+    m_counter++;
+    return mix(m_key + m_counter * GOLDEN_GAMMA);
 }
 
-i32 RandomGen::randomInt(const i32 min, const i32 max) {
-    std::uniform_int_distribution<i32> dist(min, max);
-    return dist(m_engine);
+r32 RandomGen::randomFloat(const r32 min, const r32 max)
+{
+    // The top 24 bits fill the float mantissa exactly.
+    const r32 unit = (r32)(next() >> 40) * (1.0f / 16777216.0f);
+    return min + (max - min) * unit;
+}
+
+i32 RandomGen::randomInt(const i32 min, const i32 max)
+{
+    if (max <= min) {
+        return min;
+    }
+
+    const u64 range = (u64)((i64)max - (i64)min) + 1;
+    return (i32)((i64)min + (i64)(next() % range));
 }
@@ -4,19 +4,73 @@
 #include <scl/types.h>
 #include <scl/math/help.h>
 
-#include <random>
+/**
+ * @brief What a random stream is used for, keeps streams with the same entity and tick apart.
+ */
+enum class RandomPurpose : u32
+{
+    Populate = 1,
+    Load = 2,
+    Respawn = 3,
+    Split = 4,
+    Wander = 5
+};
+
+/**
+ * @brief The seed used when none is given.
+ */
+const u64 DEFAULT_SEED = 0x5eed;
 
+/**
+ * @brief A counter based random number stream.
+ * The n-th value of a stream only depends on the key (seed, entity, tick, purpose) and n,
+ * so the results are the same no matter which thread creates the stream or in which order.
+ */
 class RandomGen {
 public:
 
-    static r32 randomFloat(const r32 min, const r32 max);
+    /**
+     * @brief Create a random stream.
+     * @param seed = The seed of the simulation.
+     * @param entity = The id of the entity the stream is for.
+     * @param tick = The tick the stream is used in.
+     * @param purpose = What the stream is used for.
+     */
+    RandomGen(u64 seed, u64 entity, u64 tick, RandomPurpose purpose);
+
+    /**
+     * @brief Get the next raw value of the stream.
+     * @return A random 64 bit value.
+     */
+    u64 next();
 
-    static i32 randomInt(const i32 min, const i32 max);
+    /**
+     * @brief Get a random float in the range [min, max).
+     * @param min = The min value.
+     * @param max = The max value.
+     * @return The random value.
+     */
+    r32 randomFloat(const r32 min, const r32 max);
+
+    /**
+     * @brief Get a random integer in the range [min, max].
+     * @param min = The min value.
+     * @param max = The max value.
+     * @return The random value.
+     */
+    i32 randomInt(const i32 min, const i32 max);
 
 private:
 
-    static std::random_device m_device;
-    static std::mt19937 m_engine;
+    /**
+     * @brief The key of the stream mixed down to a single value.
+     */
+    u64 m_key;
+
+    /**
+     * @brief The number of values taken from the stream.
+     */
+    u64 m_counter;
 
 };
 
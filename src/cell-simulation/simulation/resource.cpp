@@ -1,43 +1,57 @@
 #include "resource.h"
+#include "entitystore.h"
+#include "world.h"
+#include "fire.h"
 #include <scl/math/help.h>
 
-Resource::Resource(r32 max, vec2f location, World& world, type::ResourceType type) :
-    Entity(location, world, EntityType::Resource),
-    m_max(max),
-    m_amount(max),
-    m_resourceType(type)
+u32 Resource::create(World& world, r32 max, vec2f location, type::ResourceType type)
 {
-    m_shape.setPosition(location.x, location.y);
-    m_friction = vec2f(0.98f);
+    EntityStore& store = world.getStore();
+
+    const u32 index = store.addResource(type, location);
+    const u32 resource = store.component[index];
+
+    store.resources.max[resource] = max;
+    store.resources.amount[resource] = max;
+
+    store.friction[index] = vec2f(0.98f);
+
+    return index;
 }
 
-r32 Resource::consume(r32 amount)
+r32 Resource::consume(EntityStore& store, u32 resource, r32 amount)
 {
-    r32 toEat = clamp(amount, 0.0f, m_amount);
-    m_amount -= toEat;
+    r32& available = store.resources.amount[resource];
+
+    r32 toEat = clamp(amount, 0.0f, available);
+    available -= toEat;
     return toEat;
 }
 
-void Resource::update(const float dt)
+void Resource::update(World& world, u32 resource, const float dt)
 {
-    // Scale the radius to the amount of resource left.
-    m_radius = (m_amount / m_max) * 16.0f;
+    EntityStore& store = world.getStore();
+    ResourceComponents& resources = store.resources;
 
-    // Update the shape to reflect the new radius.
-    m_shape.setRadius(m_radius);
-    m_shape.setOrigin(m_radius, m_radius);
+    if (resources.resourceType[resource] == type::Fire) {
+        Fire::update(world, resource, dt);
+    }
+
+    const u32 index = resources.entity[resource];
+    r32& amount = resources.amount[resource];
 
-    //m_amount += 0.01f * dt;
+    // Scale the radius to the amount of resource left.
+    store.radius[index] = (amount / resources.max[resource]) * 16.0f;
+
+    //amount += 0.01f * dt;
 
     // Don't let the resource over regenerate.
-    if (m_amount > m_max) {
-        m_amount = m_max;
+    if (amount > resources.max[resource]) {
+        amount = resources.max[resource];
     }
 
     // Die when out of resource.
-    if (m_amount < 1.0f) {
-        m_alive = false;
+    if (amount < 1.0f) {
+        store.alive[index] = 0;
     }
-
-    Entity::update(dt);
 }
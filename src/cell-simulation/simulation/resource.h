@@ -19,67 +19,38 @@ enum ResourceType
 }
 
 /**
- * @brief This class represents a drainable world resource.
+ * @brief This class contains the behaviour of the drainable world resources.
  */
-class Resource : public Entity
+class Resource
 {
 public:
 
     /**
-     * @brief Default resource constructor.
+     * @brief Create a new resource in the world.
+     * @param world = The world to place the resource in.
      * @param max = The max amount of resource to start with.
      * @param location = The location of the resource in the world.
-     * @param world = The world the resource exists in.
+     * @param type = The type of resource.
+     * @return The dense entity index of the new resource.
      */
-    Resource(r32 max, vec2f location, World& world, type::ResourceType type);
+    static u32 create(World& world, r32 max, vec2f location, type::ResourceType type);
 
     /**
-     * @brief Called when the entity is updated.
+     * @brief Called when the resource is updated.
+     * @param world = The world the resource exists in.
+     * @param resource = The resource component index.
      * @param dt = The delta time.
      */
-    virtual void update(const float dt);
-
-    /**
-     * @brief Get the type of resource that this is.
-     * @return The resource type.
-     */
-    type::ResourceType getResourceType() const { return m_resourceType; }
+    static void update(World& world, u32 resource, const float dt);
 
     /**
      * @brief Consume a specific amount of resource.
+     * @param store = The store the resource exists in.
+     * @param resource = The resource component index.
      * @param amount = The amount to comsume.
      * @return The amount of resource consumed.
      */
-    r32 consume(r32 amount);
-
-    /**
-     * @brief Get the current amount of resource available.
-     * @return The amount of resource available.
-     */
-    r32 getAmount() const { return m_amount; }
-
-    /**
-     * @brief Set the amount of resource available.
-     * @param amount = The amount to set.
-     */
-    void setAmount(r32 amount) { m_amount = amount; }
-
-protected:
-
-    /**
-     * @brief The current amount of resource available.
-     */
-    r32 m_amount;
-
-    /**
-     * @brief The max amount of resource value possible.
-     */
-    r32 m_max;
-
-    /**
-     * @brief The type of resource that this is.
-     */
-    type::ResourceType m_resourceType;
+    static r32 consume(EntityStore& store, u32 resource, r32 amount);
 };
 
 #endif // RESOURCE_H_INCLUDE
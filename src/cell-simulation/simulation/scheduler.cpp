@@ -0,0 +1,69 @@
+#include "scheduler.h"
+
+Scheduler::Scheduler(r32 tickRate, u32 maxSteps) :
+    m_tickRate(60.0f),
+    m_stepTime(1.0f / 60.0f),
+    m_maxSteps(1),
+    m_turbo(0),
+    m_accumulator(0.0f),
+    m_alpha(1.0f),
+    m_tick(0),
+    m_droppedSteps(0)
+{
+    setTickRate(tickRate);
+    setMaxSteps(maxSteps);
+}
+
+void Scheduler::setTickRate(r32 tickRate)
+{
+    // Don't allow a zero or negative rate, the step time would be meaningless.
+    if (tickRate <= 0.0f) {
+        return;
+    }
+
+    m_tickRate = tickRate;
+    m_stepTime = 1.0f / tickRate;
+    m_accumulator = 0.0f;
+}
+
+void Scheduler::setTurbo(u32 turbo)
+{
+    m_turbo = turbo;
+    m_accumulator = 0.0f;
+}
+
+u32 Scheduler::advance(r32 frameTime)
+{
+    // In turbo mode we ignore the real time completely,
+    // there is nothing to blend since we are never behind or ahead.
+    if (m_turbo > 0) {
+        m_alpha = 1.0f;
+        m_tick += m_turbo;
+        return m_turbo;
+    }
+
+    if (frameTime < 0.0f) {
+        frameTime = 0.0f;
+    }
+
+    m_accumulator += frameTime;
+
+    u32 steps = (u32)(m_accumulator / m_stepTime);
+
+    if (steps > m_maxSteps) {
+
+        // We fell too far behind (a slow frame or the window was dragged),
+        // drop the extra time instead of spiraling trying to catch up.
+        m_droppedSteps += steps - m_maxSteps;
+        steps = m_maxSteps;
+        m_accumulator = 0.0f;
+    }
+    else {
+        m_accumulator -= steps * m_stepTime;
+    }
+
+    m_alpha = m_accumulator / m_stepTime;
+    m_tick += steps;
+
+    return steps;
+}
@@ -0,0 +1,134 @@
+#ifndef SCHEDULER_H_INCLUDE
+#define SCHEDULER_H_INCLUDE
+
+#include <scl/types.h>
+
+/**
+ * @brief Turns variable frame times into a number of fixed size simulation steps.
+ *
+ * Frame time is accumulated and consumed in steps of 1 / tickRate so the simulation
+ * result no longer depends on the frame rate. In turbo mode a fixed number of steps
+ * is run every frame no matter how long the frame took.
+ */
+class Scheduler
+{
+public:
+
+    /**
+     * @brief The default scheduler constructor.
+     * @param tickRate = The number of simulation steps per second of real time.
+     * @param maxSteps = The max number of steps to run in one frame when catching up.
+     */
+    Scheduler(r32 tickRate = 60.0f, u32 maxSteps = 5);
+
+    /**
+     * @brief Accumulate the frame time and calculate how many steps need to run.
+     * @param frameTime = The real time the last frame took in seconds.
+     * @return The number of steps to run this frame.
+     */
+    u32 advance(r32 frameTime);
+
+    /**
+     * @brief Get the fixed delta time of one step.
+     * @return The step time in seconds.
+     */
+    r32 getStepTime() const { return m_stepTime; }
+
+    /**
+     * @brief Get the factor used to blend the last two simulation states when rendering.
+     * @return The blend factor between 0 (previous state) and 1 (current state).
+     */
+    r32 getAlpha() const { return m_alpha; }
+
+    /**
+     * @brief Get the number of steps that have been scheduled since the start.
+     * @return The total step count.
+     */
+    u64 getTick() const { return m_tick; }
+
+    /**
+     * @brief Get the number of steps that were dropped because we fell too far behind.
+     * @return The total dropped step count.
+     */
+    u64 getDroppedSteps() const { return m_droppedSteps; }
+
+    /**
+     * @brief Get the tick rate.
+     * @return The number of steps per second.
+     */
+    r32 getTickRate() const { return m_tickRate; }
+
+    /**
+     * @brief Set the tick rate.
+     * @param tickRate = The number of steps per second.
+     */
+    void setTickRate(r32 tickRate);
+
+    /**
+     * @brief Get the max number of steps run in one frame when catching up.
+     * @return The max catch up steps.
+     */
+    u32 getMaxSteps() const { return m_maxSteps; }
+
+    /**
+     * @brief Set the max number of steps run in one frame when catching up.
+     * @param maxSteps = The max catch up steps.
+     */
+    void setMaxSteps(u32 maxSteps) { m_maxSteps = maxSteps > 0 ? maxSteps : 1; }
+
+    /**
+     * @brief Get the number of steps run per frame in turbo mode.
+     * @return The turbo steps per frame, zero when turbo mode is off.
+     */
+    u32 getTurbo() const { return m_turbo; }
+
+    /**
+     * @brief Set the number of steps run per frame in turbo mode.
+     * @param turbo = The turbo steps per frame, zero to turn turbo mode off.
+     */
+    void setTurbo(u32 turbo);
+
+private:
+
+    /**
+     * @brief The number of steps per second.
+     */
+    r32 m_tickRate;
+
+    /**
+     * @brief The fixed delta time of one step.
+     */
+    r32 m_stepTime;
+
+    /**
+     * @brief The max number of steps run in one frame when catching up.
+     */
+    u32 m_maxSteps;
+
+    /**
+     * @brief The number of steps per frame in turbo mode, zero when off.
+     */
+    u32 m_turbo;
+
+    /**
+     * @brief The frame time that has not been consumed by a step yet.
+     */
+    r32 m_accumulator;
+
+    /**
+     * @brief The blend factor between the last two simulation states.
+     */
+    r32 m_alpha;
+
+    /**
+     * @brief The total number of scheduled steps.
+     */
+    u64 m_tick;
+
+    /**
+     * @brief The total number of dropped steps.
+     */
+    u64 m_droppedSteps;
+};
+
+#endif // SCHEDULER_H_INCLUDE
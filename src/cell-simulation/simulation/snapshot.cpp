@@ -0,0 +1,367 @@
+#include "snapshot.h"
+
+// Standard includes.
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+// Project includes.
+#include "world.h"
+#include "entitystore.h"
+
+#include <util/binarystream.h>
+#include <util/log.h>
+#include <util/mappedfile.h>
+
+/**
+ * @brief The header at the start of a snapshot, written field by field.
+ */
+struct SnapshotHeader
+{
+    char magic[4];
+    u32 version;
+    u32 inputCount;
+    u32 hiddenCount;
+    u32 outputCount;
+    u32 weightCount;
+    r32 radius;
+    u64 seed;
+    u64 tick;
+    u64 runStartTick;
+    u64 runStartTime;
+    u32 idCounter;
+    u32 entityCount;
+    u32 cellCount;
+    u32 resourceCount;
+    u32 slotCount;
+    u32 freeSlotCount;
+    u32 lineageNodeCount;
+    u32 lineageDeathCount;
+    u64 lineagePrunedCount;
+};
+
+void Snapshot::capture(const World& world, std::vector<char>& buffer)
+{
+    const EntityStore& store = world.m_store;
+    const CellComponents& cells = store.cells;
+    const ResourceComponents& resources = store.resources;
+    const NeuralNetwork& network = *World::m_neuralNetwork;
+
+    buffer.clear();
+
+    BinaryWriter out(buffer);
+
+    out.writeBytes(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    out.write(SNAPSHOT_VERSION);
+    out.write(network.getInputCount());
+    out.write(network.getHiddenCount());
+    out.write(network.getOutputCount());
+    out.write(network.getWeightCount());
+    out.write(world.m_radius);
+    out.write(world.m_seed);
+    out.write(world.m_tick);
+    out.write(world.m_runStartTick);
+    out.write(world.m_runStartTime);
+    out.write(store.m_idCounter);
+    out.write(store.size());
+    out.write(cells.size());
+    out.write(resources.size());
+    out.write((u32)store.m_slotIndex.size());
+    out.write((u32)store.m_freeSlots.size());
+    out.write((u32)world.m_lineage.m_nodes.size());
+    out.write((u32)world.m_lineage.m_deaths.size());
+    out.write(world.m_lineage.m_prunedCount);
+
+    out.writeArray(store.id);
+    out.writeArray(store.type);
+    out.writeArray(store.alive);
+    out.writeArray(store.location);
+    out.writeArray(store.previousLocation);
+    out.writeArray(store.velocity);
+    out.writeArray(store.friction);
+    out.writeArray(store.radius);
+    out.writeArray(store.rotation);
+    out.writeArray(store.mass);
+    out.writeArray(store.color);
+    out.writeArray(store.component);
+
+    out.writeArray(store.m_slots);
+    out.writeArray(store.m_slotIndex);
+    out.writeArray(store.m_slotGeneration);
+    out.writeArray(store.m_freeSlots);
+
+    out.writeArray(cells.entity);
+    out.writeArray(cells.generation);
+    out.writeArray(cells.foodAmount);
+    out.writeArray(cells.splitTimer);
+    out.writeArray(cells.memory);
+
+    for (u32 cell = 0; cell < cells.size(); cell++) {
+        const DNA& dna = cells.dna[cell];
+        out.write(dna.traits);
+        out.writeBytes(dna.genome.readWeights(), dna.genome.getLength() * sizeof(r32));
+    }
+
+    out.writeArray(resources.entity);
+    out.writeArray(resources.resourceType);
+    out.writeArray(resources.amount);
+    out.writeArray(resources.max);
+    out.writeArray(resources.timer);
+
+    out.writeArray(world.m_lineage.m_nodes);
+    out.writeArray(world.m_lineage.m_deaths);
+}
+
+bool Snapshot::restore(World& world, const char* data, std::size_t size)
+{
+    const NeuralNetwork& network = *World::m_neuralNetwork;
+
+    BinaryReader in(data, size);
+
+    SnapshotHeader header;
+    in.readBytes(header.magic, sizeof(header.magic));
+    in.read(header.version);
+
+    if (in.hasFailed() ||
+        std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != SNAPSHOT_VERSION) {
+
+        Log::error("unknown snapshot format");
+        return false;
+    }
+
+    in.read(header.inputCount);
+    in.read(header.hiddenCount);
+    in.read(header.outputCount);
+    in.read(header.weightCount);
+    in.read(header.radius);
+    in.read(header.seed);
+    in.read(header.tick);
+    in.read(header.runStartTick);
+    in.read(header.runStartTime);
+    in.read(header.idCounter);
+    in.read(header.entityCount);
+    in.read(header.cellCount);
+    in.read(header.resourceCount);
+    in.read(header.slotCount);
+    in.read(header.freeSlotCount);
+    in.read(header.lineageNodeCount);
+    in.read(header.lineageDeathCount);
+    in.read(header.lineagePrunedCount);
+
+    if (in.hasFailed()) {
+        Log::error("snapshot is truncated");
+        return false;
+    }
+
+    // The genomes only make sense to the network they were evolved for,
+    // and the spatial grid was sized for the radius of this world.
+    if (header.inputCount != network.getInputCount() ||
+        header.hiddenCount != network.getHiddenCount() ||
+        header.outputCount != network.getOutputCount() ||
+        header.weightCount != network.getWeightCount() ||
+        header.radius != world.m_radius) {
+
+        Log::error("snapshot was saved for a different network or world size");
+        return false;
+    }
+
+    if (header.cellCount + header.resourceCount != header.entityCount ||
+        header.slotCount < header.entityCount ||
+        header.freeSlotCount != header.slotCount - header.entityCount) {
+
+        Log::error("snapshot entity counts don't add up");
+        return false;
+    }
+
+    // Read into a new store so the world is untouched if anything goes wrong.
+    EntityStore store;
+    CellComponents& cells = store.cells;
+    ResourceComponents& resources = store.resources;
+
+    store.m_idCounter = header.idCounter;
+
+    in.readArray(store.id, header.entityCount);
+    in.readArray(store.type, header.entityCount);
+    in.readArray(store.alive, header.entityCount);
+    in.readArray(store.location, header.entityCount);
+    in.readArray(store.previousLocation, header.entityCount);
+    in.readArray(store.velocity, header.entityCount);
+    in.readArray(store.friction, header.entityCount);
+    in.readArray(store.radius, header.entityCount);
+    in.readArray(store.rotation, header.entityCount);
+    in.readArray(store.mass, header.entityCount);
+    in.readArray(store.color, header.entityCount);
+    in.readArray(store.component, header.entityCount);
+
+    in.readArray(store.m_slots, header.entityCount);
+    in.readArray(store.m_slotIndex, header.slotCount);
+    in.readArray(store.m_slotGeneration, header.slotCount);
+    in.readArray(store.m_freeSlots, header.freeSlotCount);
+
+    in.readArray(cells.entity, header.cellCount);
+    in.readArray(cells.generation, header.cellCount);
+    in.readArray(cells.foodAmount, header.cellCount);
+    in.readArray(cells.splitTimer, header.cellCount);
+    in.readArray(cells.memory, header.cellCount);
+
+    if (!in.hasFailed()) {
+
+        cells.dna.reserve(header.cellCount);
+
+        for (u32 cell = 0; cell < header.cellCount; cell++) {
+
+            Traits traits;
+            in.read(traits);
+
+            const char* weights = in.skip(header.weightCount * sizeof(r32));
+            if (!weights)
+                break;
+
+            // The weights are four byte aligned since everything before them is a multiple of four bytes.
+            cells.dna.push_back(DNA(Genome((const r32*)weights, header.weightCount), traits));
+        }
+    }
+
+    in.readArray(resources.entity, header.resourceCount);
+    in.readArray(resources.resourceType, header.resourceCount);
+    in.readArray(resources.amount, header.resourceCount);
+    in.readArray(resources.max, header.resourceCount);
+    in.readArray(resources.timer, header.resourceCount);
+
+    Lineage lineage;
+    in.readArray(lineage.m_nodes, header.lineageNodeCount);
+    in.readArray(lineage.m_deaths, header.lineageDeathCount);
+    lineage.m_prunedCount = header.lineagePrunedCount;
+    lineage.m_compactSize = std::max<u64>(LINEAGE_MIN_COMPACT_SIZE, (u64)header.lineageNodeCount * 2);
+
+    if (in.hasFailed()) {
+        Log::error("snapshot is truncated");
+        return false;
+    }
+
+    // An unknown type would send the entity to the wrong component array.
+    for (u32 i = 0; i < header.entityCount; i++) {
+        if (store.type[i] != EntityType::Cell && store.type[i] != EntityType::Resource) {
+            Log::error("snapshot has an unknown entity type");
+            return false;
+        }
+    }
+
+    for (u32 i = 0; i < header.resourceCount; i++) {
+        if ((u32)resources.resourceType[i] > (u32)type::Fire) {
+            Log::error("snapshot has an unknown resource type");
+            return false;
+        }
+    }
+
+    // Check the indices link up before anything indexes with them.
+    for (u32 i = 0; i < header.entityCount; i++) {
+
+        const bool isCell = store.type[i] == EntityType::Cell;
+        const std::vector<u32>& owners = isCell ? cells.entity : resources.entity;
+
+        if (store.component[i] >= owners.size() || owners[store.component[i]] != i ||
+            store.m_slots[i] >= header.slotCount || store.m_slotIndex[store.m_slots[i]] != i) {
+
+            Log::error("snapshot entity indices are corrupt");
+            return false;
+        }
+    }
+
+    // Every slot has to be either used by the one entity it points back at, or free exactly once,
+    // the next entity added takes a free slot and indexes the slot arrays with it.
+    std::vector<u8> slotUsed(header.slotCount, 0);
+
+    for (u32 i = 0; i < header.entityCount; i++)
+        slotUsed[store.m_slots[i]] = 1;
+
+    for (u32 i = 0; i < header.freeSlotCount; i++) {
+
+        const u32 slot = store.m_freeSlots[i];
+
+        if (slot >= header.slotCount || slotUsed[slot]) {
+            Log::error("snapshot free slots are corrupt");
+            return false;
+        }
+
+        slotUsed[slot] = 1;
+    }
+
+    store.recount();
+
+    world.m_store = std::move(store);
+    world.m_lineage = std::move(lineage);
+    world.m_seed = header.seed;
+    world.m_tick = header.tick;
+    world.m_runStartTick = header.runStartTick;
+    world.m_runStartTime = header.runStartTime;
+
+    world.rebuildIndex();
+
+    return true;
+}
+
+bool Snapshot::save(const std::string& filePath, const World& world)
+{
+    std::vector<char> buffer;
+    capture(world, buffer);
+
+    if (!writeFileAtomic(filePath, buffer.data(), buffer.size())) {
+        Log::error("failed to write snapshot: " + filePath);
+        return false;
+    }
+
+    return true;
+}
+
+bool Snapshot::load(const std::string& filePath, World& world)
+{
+    MappedFile file;
+
+    if (!file.open(filePath))
+        return false;
+
+    if (!restore(world, file.getData(), file.getSize())) {
+        Log::error("failed to restore snapshot: " + filePath);
+        return false;
+    }
+
+    return true;
+}
+
+bool Snapshot::readInfo(const std::string& filePath, SnapshotInfo& info)
+{
+    MappedFile file;
+
+    if (!file.open(filePath))
+        return false;
+
+    BinaryReader in(file.getData(), file.getSize());
+
+    SnapshotHeader header;
+    in.readBytes(header.magic, sizeof(header.magic));
+    in.read(header.version);
+    in.read(header.inputCount);
+    in.read(header.hiddenCount);
+    in.read(header.outputCount);
+    in.read(header.weightCount);
+    in.read(header.radius);
+    in.read(header.seed);
+    in.read(header.tick);
+    in.read(header.runStartTick);
+    in.read(header.runStartTime);
+
+    if (in.hasFailed() ||
+        std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != SNAPSHOT_VERSION) {
+        return false;
+    }
+
+    info.seed = header.seed;
+    info.tick = header.tick;
+    info.runStartTick = header.runStartTick;
+    info.runStartTime = header.runStartTime;
+
+    return true;
+}
@@ -0,0 +1,118 @@
+#ifndef SNAPSHOT_H_INCLUDE
+#define SNAPSHOT_H_INCLUDE
+
+// Standard includes.
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <scl/types.h>
+
+class World;
+
+/**
+ * @brief Identifies a snapshot file, the first four bytes of the file.
+ */
+const char SNAPSHOT_MAGIC[4] = { 'C', 'S', 'N', 'P' };
+
+/**
+ * @brief The current version of the snapshot format, bump it when the layout changes.
+ */
+const u32 SNAPSHOT_VERSION = 4;
+
+/**
+ * @brief What a snapshot file says about itself, read without restoring it.
+ */
+struct SnapshotInfo
+{
+    /**
+     * @brief The seed of the run.
+     */
+    u64 seed;
+
+    /**
+     * @brief The tick the snapshot was taken at.
+     */
+    u64 tick;
+
+    /**
+     * @brief The tick the run was started fresh at.
+     */
+    u64 runStartTick;
+
+    /**
+     * @brief The system time the run was started fresh at, in nanoseconds since the epoch.
+     */
+    u64 runStartTime;
+
+    /**
+     * @brief Check if two snapshots were taken of the same run.
+     * @param other = The other snapshot.
+     * @return True if the seed and the start of the run match.
+     */
+    bool isSameRun(const SnapshotInfo& other) const
+    {
+        return seed == other.seed && runStartTick == other.runStartTick && runStartTime == other.runStartTime;
+    }
+};
+
+/**
+ * @brief Saves and restores the complete state of a world.
+ *
+ * A snapshot holds every entity with all of its physics and component state, the entity
+ * store slot map and id counter, the seed, the tick and the lineage of the cells. It also
+ * names the run it was taken of, by the seed and the tick and time the run was started fresh,
+ * so the snapshots of one run are never mistaken for those of another. The random streams are keyed on
+ * the seed, the entity id and the tick, so restoring a snapshot and updating gives exactly
+ * the same run as if the world had never stopped.
+ *
+ * The arrays of the entity store are written as they are, in the byte order of the
+ * machine, so a snapshot is only meant to be read back on the same kind of machine.
+ */
+class Snapshot
+{
+public:
+
+    /**
+     * @brief Write the state of a world into a buffer.
+     * @param world = The world to capture.
+     * @param buffer = The buffer to write to, it is cleared first.
+     */
+    static void capture(const World& world, std::vector<char>& buffer);
+
+    /**
+     * @brief Replace the state of a world with a captured one.
+     * The world is left untouched if the snapshot is invalid.
+     * @param world = The world to restore.
+     * @param data = The captured state.
+     * @param size = The size of the captured state in bytes.
+     * @return True if sucessful.
+     */
+    static bool restore(World& world, const char* data, std::size_t size);
+
+    /**
+     * @brief Capture a world and write it to a file.
+     * @param filePath = The path of the file to write.
+     * @param world = The world to capture.
+     * @return True if sucessful.
+     */
+    static bool save(const std::string& filePath, const World& world);
+
+    /**
+     * @brief Restore a world from a file.
+     * @param filePath = The path of the file to read.
+     * @param world = The world to restore.
+     * @return True if sucessful.
+     */
+    static bool load(const std::string& filePath, World& world);
+
+    /**
+     * @brief Read the run and the tick a snapshot file was taken of without restoring it.
+     * @param filePath = The path of the file to read.
+     * @param info = Set to the run and tick of the snapshot.
+     * @return True if the file exists and is a snapshot.
+     */
+    static bool readInfo(const std::string& filePath, SnapshotInfo& info);
+};
+
+#endif // SNAPSHOT_H_INCLUDE
@@ -0,0 +1,152 @@
+#include "threadpool.h"
+
+ThreadPool::ThreadPool(u32 threadCount) :
+    m_function(0),
+    m_pending(0),
+    m_generation(0),
+    m_running(true)
+{
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+
+    for (u32 i = 0; i < threadCount; i++) {
+        m_queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+    }
+
+    // The calling thread is the last worker so we only need to start the others.
+    for (u32 i = 0; i + 1 < threadCount; i++) {
+        m_threads.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+
+    m_wake.notify_all();
+
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::parallelFor(u32 count, u32 grainSize, const RangeFunction& function)
+{
+    if (count == 0) {
+        return;
+    }
+
+    if (grainSize == 0) {
+        grainSize = 1;
+    }
+
+    const u32 caller = m_queues.size() - 1;
+
+    // Not worth waking anyone up for a single range.
+    if (m_threads.empty() || count <= grainSize) {
+        function(0, count, caller);
+        return;
+    }
+
+    m_function = &function;
+
+    // Deal the ranges out so every queue starts with a contiguous block.
+    const u32 rangeCount = (count + grainSize - 1) / grainSize;
+    const u32 perQueue = (rangeCount + m_queues.size() - 1) / m_queues.size();
+
+    m_pending.store(rangeCount);
+
+    for (u32 i = 0; i < rangeCount; i++) {
+
+        Range range;
+        range.begin = i * grainSize;
+        range.end = std::min(range.begin + grainSize, count);
+
+        WorkQueue& queue = *m_queues[i / perQueue];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.ranges.push_back(range);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_generation++;
+    }
+
+    m_wake.notify_all();
+
+    // Help out until everything has been run, the last few ranges may still be running on the workers.
+    while (m_pending.load(std::memory_order_acquire) > 0) {
+        if (!runRange(caller)) {
+            std::this_thread::yield();
+        }
+    }
+
+    m_function = 0;
+}
+
+void ThreadPool::workerLoop(u32 worker)
+{
+    u64 generation = 0;
+
+    while (true) {
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return !m_running || m_generation != generation; });
+
+            if (!m_running) {
+                return;
+            }
+
+            generation = m_generation;
+        }
+
+        while (runRange(worker)) { }
+    }
+}
+
+bool ThreadPool::runRange(u32 worker)
+{
+    const u32 queueCount = m_queues.size();
+
+    for (u32 i = 0; i < queueCount; i++) {
+
+        WorkQueue& queue = *m_queues[(worker + i) % queueCount];
+        Range range;
+
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            if (queue.ranges.empty()) {
+                continue;
+            }
+
+            // Work from the front of our own queue and steal from the back of the others,
+            // that keeps each worker on neighbouring ranges as long as possible.
+            if (i == 0) {
+                range = queue.ranges.front();
+                queue.ranges.pop_front();
+            }
+            else {
+                range = queue.ranges.back();
+                queue.ranges.pop_back();
+            }
+        }
+
+        (*m_function)(range.begin, range.end, worker);
+
+        m_pending.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,125 @@
+#ifndef THREADPOOL_H_INCLUDE
+#define THREADPOOL_H_INCLUDE
+
+// Standard includes.
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <scl/types.h>
+
+/**
+ * @brief A fixed set of worker threads used to split loops over the entities into ranges.
+ * Each worker has its own queue of ranges, when it runs out it steals from the other queues.
+ * The thread calling parallelFor works on the ranges too and is always the last worker index.
+ */
+class ThreadPool
+{
+public:
+
+    /**
+     * @brief The function run for each range, the worker index can be used to pick per thread data.
+     */
+    typedef std::function<void(u32 begin, u32 end, u32 worker)> RangeFunction;
+
+    /**
+     * @brief Create the thread pool.
+     * @param threadCount = The number of threads to work with including the calling thread, (0 for one per core)
+     */
+    explicit ThreadPool(u32 threadCount = 0);
+
+    /**
+     * @brief Stop and join all of the worker threads.
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief Get the number of workers including the calling thread.
+     * @return The number of workers, per thread data should be sized to this.
+     */
+    u32 getWorkerCount() const { return m_queues.size(); }
+
+    /**
+     * @brief Split [0, count) into ranges and run the function over them on all of the workers.
+     * Returns once every range has been run.
+     * @param count = The number of items.
+     * @param grainSize = The number of items in each range.
+     * @param function = The function to run for each range.
+     */
+    void parallelFor(u32 count, u32 grainSize, const RangeFunction& function);
+
+private:
+
+    struct Range
+    {
+        u32 begin;
+        u32 end;
+    };
+
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Range> ranges;
+    };
+
+    /**
+     * @brief The main loop of a worker thread.
+     * @param worker = The index of the worker.
+     */
+    void workerLoop(u32 worker);
+
+    /**
+     * @brief Run one range, taking it from our own queue first and stealing from the others after that.
+     * @param worker = The index of the worker.
+     * @return True if a range was run, false if there was no work left.
+     */
+    bool runRange(u32 worker);
+
+    /**
+     * @brief The worker threads, one less than the worker count.
+     */
+    std::vector<std::thread> m_threads;
+
+    /**
+     * @brief The queue of ranges for each worker.
+     */
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+
+    /**
+     * @brief The function of the current parallelFor.
+     */
+    const RangeFunction* m_function;
+
+    /**
+     * @brief The number of ranges that have not finished yet.
+     */
+    std::atomic<u32> m_pending;
+
+    /**
+     * @brief Guards the wake up of the workers.
+     */
+    std::mutex m_mutex;
+
+    /**
+     * @brief Signalled when new work is added or the pool is stopping.
+     */
+    std::condition_variable m_wake;
+
+    /**
+     * @brief Increased every time work is added, the workers use it to know there is new work.
+     */
+    u64 m_generation;
+
+    /**
+     * @brief Cleared to stop the worker threads.
+     */
+    bool m_running;
+};
+
+#endif // THREADPOOL_H_INCLUDE
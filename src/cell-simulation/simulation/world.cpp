@@ -1,22 +1,36 @@
 #include "world.h"
 
-#include "../core/console.h"
-#include "../core/content.h"
 #include "../mathutils.h"
 #include "randomgen.h"
 
 #include <util/log.h>
+#include <util/profiler.h>
 
 #include "cell.h"
 #include "food.h"
 #include "fire.h"
+#include "resource.h"
+#include "snapshot.h"
+#include "genetics/population.h"
 
-#include <sstream>
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 
 NeuralNetwork* World::m_neuralNetwork = 0;
 u32 World::m_weightCount = 0;
 
+static const ProfileZone TICK_ZONE = Profiler::addZone("tick");
+static const ProfileZone SENSE_ZONE = Profiler::addZone("sense");
+static const ProfileZone THINK_ZONE = Profiler::addZone("think");
+static const ProfileZone RESOURCES_ZONE = Profiler::addZone("resources");
+static const ProfileZone INTEGRATE_ZONE = Profiler::addZone("integrate");
+static const ProfileZone COLLIDE_ZONE = Profiler::addZone("collide");
+static const ProfileZone SPAWN_ZONE = Profiler::addZone("spawn");
+static const ProfileZone LINEAGE_ZONE = Profiler::addZone("lineage");
+static const ProfileZone INDEX_ZONE = Profiler::addZone("index");
+static const ProfileZone CHECKPOINT_ZONE = Profiler::addZone("checkpoint");
+
 /*
  * Simulate like a colony
  * Where each entity has a set purpose.
@@ -24,14 +38,18 @@ u32 World::m_weightCount = 0;
  * Workes
  */
 
-// 8192.0f
-World::World() :
-    m_radius(2046.0f),
-    m_spatialHash(m_radius),
-    m_debug(false)
+World::World(r32 radius) :
+    m_radius(radius),
+    m_seed(DEFAULT_SEED),
+    m_tick(0),
+    m_runStartTick(0),
+    m_runStartTime(0),
+    m_spatialGrid(m_radius)
 {
+    setThreadCount(0);
+
     // TODO (Tyler): Fine tune the hidden nodes.
-    m_neuralNetwork = new NeuralNetwork(19, 16, 4);
+    m_neuralNetwork = new NeuralNetwork(CELL_NETWORK_INPUTS, CELL_NETWORK_HIDDEN, CELL_NETWORK_OUTPUTS);
     m_weightCount = m_neuralNetwork->getWeightCount();
 }
 
@@ -45,61 +63,45 @@ World::~World()
 
 void World::saveState()
 {
-    std::ofstream out;
-    out.open("../../data/dna.dat", std::ios::out | std::ios::binary);
-
-    if (!out.is_open())
-        return;
-
-    u64 entityCount = 0;
-
-    for (Entity* e : m_entities)
-        if (e->getType() == EntityType::Cell)
-            entityCount++;
-
-    out << entityCount << std::endl;
-
-    for (Entity* e : m_entities)
-    if (e->getType() == EntityType::Cell){
-        Cell* cell = static_cast<Cell*>(e);
-        DNA dna = cell->getDna();
-
-        out << cell->getGeneration() << std::endl;
+    if (!PopulationFile::save(POPULATION_FILE_PATH, m_store.cells, *m_neuralNetwork)) {
+        Log::error("failed to save the population");
+    }
+}
 
-        out << dna.traits.red << std::endl;
-        out << dna.traits.green << std::endl;
-        out << dna.traits.blue << std::endl;
+void World::loadState()
+{
+    PopulationFile file;
 
-        out << dna.traits.eyeLengthA << std::endl;
-        out << dna.traits.eyeLengthB << std::endl;
-        out << dna.traits.eyeLengthC << std::endl;
-        out << dna.traits.eyeOffsetA << std::endl;
-        out << dna.traits.eyeOffsetB << std::endl;
+    if (!file.open(POPULATION_FILE_PATH, *m_neuralNetwork)) {
+        loadLegacyState();
+        return;
+    }
 
-        out << dna.traits.mutationRate << std::endl;
-        out << dna.traits.splitRate << std::endl;
+    // The records are used straight out of the mapped file, only the genome weights are copied.
+    for (u64 i = 0; i < file.getEntityCount(); i++) {
+        RandomGen random(m_seed, i, m_tick, RandomPurpose::Load);
 
-        const r32* genome = dna.genome.readWeights();
+        DNA dna(Genome(file.getWeights(i), m_weightCount), file.getTraits(i));
 
-        for (u64 i = 0; i < dna.genome.getLength(); i++)
-            out << genome[i] << std::endl;
+        Cell::create(*this, file.getGeneration(i), std::move(dna), randomWorldPoint(random));
     }
-
-    out.close();
 }
 
-void World::loadState()
+void World::loadLegacyState()
 {
     std::ifstream in;
-    in.open("../../data/dna.dat", std::ios::in | std::ios::binary);
+    in.open(LEGACY_POPULATION_FILE_PATH.c_str(), std::ios::in | std::ios::binary);
 
     if (!in.is_open())
         return;
 
+    Log::info("importing the old population file: ", LEGACY_POPULATION_FILE_PATH);
+
     u64 entityCount = 0;
     in >> entityCount;
 
     for (u64 i = 0; i < entityCount; i++) {
+        RandomGen random(m_seed, i, m_tick, RandomPurpose::Load);
         DNA dna;
 
         i32 generation = 0;
@@ -122,188 +124,368 @@ void World::loadState()
         for (u64 i = 0; i < dna.genome.getLength(); i++)
             in >> genome[i];
 
-        m_entities.push_back(new Cell(generation, dna, randomWorldPoint(), *this));
+        Cell::create(*this, generation, std::move(dna), randomWorldPoint(random));
     }
 
     in.close();
 }
 
 
-bool World::initialize()
+bool World::initialize(bool resume)
 {
-    m_border.setRadius(m_radius);
-    m_border.setOrigin(m_radius, m_radius);
-    m_border.setFillColor(sf::Color(32, 32, 32, 255));
-    m_border.setOutlineColor(sf::Color(128, 128, 128, 255));
-    m_border.setOutlineThickness(10.0f);
-    m_border.setPointCount(100);
+    Log::info("neural network kernel: ", getKernelName(m_neuralNetwork->getKernel()));
 
-    m_vertexQuadArray.setPrimitiveType(sf::Quads);
-    m_vertexLineArray.setPrimitiveType(sf::Lines);
+    // Carry on exactly where the last run stopped, from the snapshot it saved on exit
+    // or from its newest checkpoint if it never got that far.
+    std::string snapshotPath;
+    if (resume) {
 
-    m_debugText = new sf::Text();
-    m_debugText->setFont(*Content::font);
-    m_debugText->setPosition(0.0f, 100.0f);
-    m_debugText->setCharacterSize(16);
+        if (Checkpointer::findLatest(SNAPSHOT_FILE_PATH, snapshotPath) && Snapshot::load(snapshotPath, *this)) {
 
-    loadState();
+            Log::info("resumed from ", snapshotPath, " at tick: ", m_tick, ", seed: ", m_seed,
+                      ", entities: ", m_store.size(), ", cells: ", m_store.cells.size());
+
+            return true;
+        }
 
-	if (m_entities.size() < 50) {
-		for (i32 i = 0; i < m_entities.size()-50; i++) {
-			Cell* newCell = new Cell(1, DNA(), randomWorldPoint(), *this);
-			newCell->setMass(100.0f);
-			m_entities.push_back(newCell);
-		}
-	}
-
-    for (i32 i = 0; i < 50; i++) {
-        Fire* newCell = new Fire(randomWorldPoint(), *this);
-        newCell->setMass(100.0f);
-        m_entities.push_back(newCell);
+        Log::info("there is no run to resume, starting a fresh one");
     }
 
+    // A fresh run gets its own identity so its checkpoints are never confused with an older run.
+    m_runStartTick = m_tick;
+    m_runStartTime = (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
 
-    for (i32 i = 0; i < 250; i++)
-       m_entities.push_back(new Food(randomWorldPoint(), *this));
+    Log::info("world seed: ", m_seed);
 
-    m_spatialHash.buildArray(m_vertexQuadArray, sf::Quads);
-    m_spatialHash.buildArray(m_vertexLineArray, sf::Lines);
+    loadState();
 
-    updateEntityText();
+    // Top the population up to the minimum if the saved state was missing or small.
+    const u32 cellCount = m_store.cells.size();
+    populate((cellCount < START_CELL_COUNT) ? START_CELL_COUNT - cellCount : 0, START_FIRE_COUNT, START_FOOD_COUNT);
 
     return true;
 }
 
+void World::populate(u32 cellCount, u32 fireCount, u32 foodCount)
+{
+    RandomGen random(m_seed, 0, m_tick, RandomPurpose::Populate);
+
+    for (u32 i = 0; i < cellCount; i++) {
+        const u32 newCell = Cell::create(*this, 1, DNA(random), randomWorldPoint(random));
+        m_store.mass[newCell] = 100.0f;
+    }
+
+    for (u32 i = 0; i < fireCount; i++) {
+        const u32 newFire = Fire::create(*this, randomWorldPoint(random), random);
+        m_store.mass[newFire] = 100.0f;
+    }
+
+    for (u32 i = 0; i < foodCount; i++)
+       Food::create(*this, randomWorldPoint(random), random);
+
+    rebuildIndex();
+}
+
 void World::destroy()
 {
-    if (m_debugText)
-        delete m_debugText;
+    m_checkpointer.flush();
 
+    Snapshot::save(SNAPSHOT_FILE_PATH, *this);
     saveState();
 
-    for (auto& entity : m_entities) {
-        delete entity;
+    m_checkpointer.removeStale();
+
+    m_lineage.writeNewick(LINEAGE_FILE_PATH);
+    m_lineage.clear();
+
+    m_events.close();
+
+    m_store.clear();
+}
+
+bool World::setKernel(const std::string& name)
+{
+    NetworkKernel kernel;
+
+    if (!findKernel(name, kernel)) {
+        Log::error("unknown network kernel: ", name);
+        return false;
     }
 
-    m_entities.clear();
+    if (!m_neuralNetwork->setKernel(kernel)) {
+        Log::error("the network kernel isn't supported on this cpu: ", name);
+        return false;
+    }
+
+    return true;
+}
+
+void World::setThreadCount(u32 threadCount)
+{
+    m_threadPool.reset(new ThreadPool(threadCount));
+    m_commandBuffers.resize(m_threadPool->getWorkerCount());
 }
 
 void World::update(const float dt)
 {
-    bool hasChanged = false;
-    bool entityDied = false;
+    // The update is split into phases. The parallel phases only write to the entity they are working on,
+    // anything else is recorded into the command buffer of the worker and applied when the phase is done.
+    // New entities are only added in the spawn phase, at the end of the arrays, so they join on the next update.
+    // The spatial grid stores dense indices so it is rebuilt last, once the arrays stop changing.
+
+    {
+        ProfileScope zone(TICK_ZONE);
+
+        sense();
+        think(dt);
+        updateResources(dt);
+        integrate(dt);
+        collide();
+        spawn(dt);
+        rebuildIndex();
+
+        m_tick++;
+
+        ProfileScope checkpointZone(CHECKPOINT_ZONE);
+        m_checkpointer.update(*this);
+    }
+
+    // A trace covers a number of whole ticks, with anything else recorded between them.
+    Profiler::endTick();
+}
+
+void World::sense()
+{
+    ProfileScope zone(SENSE_ZONE);
 
-    for (i32 i = m_entities.size() - 1; i >= 0; i--) {
-        Entity* entity = m_entities[i];
-        if (entity->isAlive()) {
+    const u32 cellCount = m_store.cells.size();
 
-            entity->update(dt);
+    m_networkInputs.resize(cellCount * CELL_NETWORK_INPUTS);
+    m_networkOutputs.resize(cellCount * CELL_NETWORK_OUTPUTS);
+    m_networkWeights.resize(cellCount);
 
-            if (entity->updateHash()) {
-                m_spatialHash.update(entity);
-                hasChanged = true;
+    // Gather the inputs and the genome weights of every cell.
+    m_threadPool->parallelFor(cellCount, 64, [&](u32 begin, u32 end, u32) {
+
+        for (u32 cell = begin; cell < end; cell++) {
+
+            m_networkWeights[cell] = m_store.cells.dna[cell].genome.readWeights();
+
+            if (m_store.alive[m_store.cells.entity[cell]]) {
+                Cell::sense(*this, cell, &m_networkInputs[cell * CELL_NETWORK_INPUTS]);
             }
         }
-        else {
+    });
+}
 
-            m_entities.erase(m_entities.begin() + i);
-            onDeath(entity);
+void World::think(const float dt)
+{
+    ProfileScope zone(THINK_ZONE);
 
-            // Make sure we remove the entity from the spatialhash and all of the nodes that it exists in.
-            // This can cause problems because a node may contain a null reference to an entity which causesa c crash.
-            m_spatialHash.remove(entity);
+    const u32 cellCount = m_networkWeights.size();
 
-            delete entity;
-            entityDied = true;
-        }
-    }
+    m_threadPool->parallelFor(cellCount, 64, [&](u32 begin, u32 end, u32) {
 
-    if (hasChanged && m_debug) {
-        m_vertexQuadArray.clear();
-        m_vertexLineArray.clear();
-        m_spatialHash.buildArray(m_vertexQuadArray, sf::Quads);
-        m_spatialHash.buildArray(m_vertexLineArray, sf::Lines);
-    }
+        m_neuralNetwork->computeBatch(&m_networkWeights[begin],
+                                      &m_networkInputs[begin * CELL_NETWORK_INPUTS],
+                                      &m_networkOutputs[begin * CELL_NETWORK_OUTPUTS],
+                                      end - begin);
 
-    if (entityDied) {
-        updateEntityText();
-    }
+        for (u32 cell = begin; cell < end; cell++) {
+            if (m_store.alive[m_store.cells.entity[cell]]) {
+                Cell::update(*this, cell, &m_networkOutputs[cell * CELL_NETWORK_OUTPUTS], dt);
+            }
+        }
+    });
 }
 
-void World::updateEntityText()
+void World::updateResources(const float dt)
 {
-    std::stringstream sb;
-    sb << "entity count: " << m_entities.size() << std::endl;
-    sb << "cell count: " << Cell::m_cellCount;
-    m_debugText->setString(sb.str());
+    ProfileScope zone(RESOURCES_ZONE);
+
+    m_threadPool->parallelFor(m_store.resources.size(), 256, [&](u32 begin, u32 end, u32) {
+
+        for (u32 resource = begin; resource < end; resource++) {
+            if (m_store.alive[m_store.resources.entity[resource]]) {
+                Resource::update(*this, resource, dt);
+            }
+        }
+    });
 }
 
-void World::onDeath(Entity* entity)
+void World::integrate(const float dt)
 {
-    if (entity->getType() == EntityType::Cell) {
+    ProfileScope zone(INTEGRATE_ZONE);
 
-        Cell* cell = (Cell*)entity;
-        if (cell) {
+    m_threadPool->parallelFor(m_store.size(), 1024, [&](u32 begin, u32 end, u32) {
 
-            //std::stringstream sb;
-            //sb << "entity died at generation: " << cell->getGeneration();
+        for (u32 i = begin; i < end; i++) {
+            if (m_store.alive[i]) {
+                Entity::integrate(*this, i, dt);
+            }
+        }
+    });
+}
 
-            //Console::write(sb.str());
+void World::collide()
+{
+    ProfileScope zone(COLLIDE_ZONE);
 
-            if (Cell::m_cellCount <= 10) {
-				m_entities.push_back(new Cell(1, DNA(), randomWorldPoint(), *this));
+    m_threadPool->parallelFor(m_store.size(), 256, [&](u32 begin, u32 end, u32 worker) {
+
+        CommandBuffer& buffer = m_commandBuffers[worker];
+
+        for (u32 i = begin; i < end; i++) {
+            if (m_store.alive[i]) {
+                Entity::findCollisions(*this, i, buffer);
             }
         }
+    });
+
+    // Merge the buffers and sort them so the collisions are resolved in the same order
+    // no matter which worker happened to find them.
+    std::vector<CollisionCommand>& collisions = m_commandBuffers[0].collisions;
 
+    for (u32 i = 1; i < m_commandBuffers.size(); i++) {
+
+        std::vector<CollisionCommand>& other = m_commandBuffers[i].collisions;
+        collisions.insert(collisions.end(), other.begin(), other.end());
+        other.clear();
+    }
+
+    std::sort(collisions.begin(), collisions.end());
+
+    for (auto& collision : collisions) {
+        m_events.collision(m_tick, m_store.id[collision.entity], m_store.id[collision.other]);
+        Entity::collide(*this, collision.entity, collision.other);
     }
-    else if (entity->getType() == EntityType::Resource) {
 
-        Resource* resource = (Resource*)entity;
-        if (resource->getResourceType() == type::Food) {
-            m_entities.push_back(new Food(randomWorldPoint(), *this));
+    collisions.clear();
+}
+
+void World::rebuildIndex()
+{
+    ProfileScope zone(INDEX_ZONE);
+
+    m_spatialGrid.rebuild(m_store.location);
+}
+
+void World::spawn(const float dt)
+{
+    ProfileScope zone(SPAWN_ZONE);
+
+    // The spawn phase runs on the calling thread, which is always the last worker.
+    CommandBuffer& buffer = m_commandBuffers.back();
+
+    // Split the cells that are ready, the babies are held back until the dead are gone
+    // so nothing is added to the arrays while they are being walked.
+    const u32 cellCount = m_store.cells.size();
+    for (u32 cell = 0; cell < cellCount; cell++) {
+        if (m_store.alive[m_store.cells.entity[cell]]) {
+            Cell::splitCell(*this, cell, dt, buffer);
         }
     }
+
+    removeDead(buffer);
+    applyBirths(buffer);
+
+    // The births and deaths are only appended, the extinct branches are pruned once the lineage has doubled.
+    if (m_lineage.needsCompaction()) {
+        ProfileScope lineageZone(LINEAGE_ZONE);
+        m_lineage.compact();
+    }
+}
+
+void World::removeDead(CommandBuffer& buffer)
+{
+    // Walk backwards so the entity moved into a removed index has already been visited.
+    for (i32 i = m_store.size() - 1; i >= 0; i--) {
+
+        if (m_store.alive[i])
+            continue;
+
+        onDeath(i, buffer);
+
+        m_store.remove(i);
+    }
 }
 
-void World::render(sf::RenderTarget& target, Camera& camera, const sf::View& textView)
+void World::applyBirths(CommandBuffer& buffer)
 {
-    // Setup the camera view for the world
-    camera.render(target);
+    for (auto& birth : buffer.births) {
 
-    target.draw(m_border, Content::shader);
+        const u32 baby = Cell::create(*this, birth.generation, std::move(birth.dna), birth.location, birth.parent);
 
-    if (m_debug) {
-        target.draw(m_vertexQuadArray, Content::shader);
-        target.draw(m_vertexLineArray, Content::shader);
+        m_store.mass[baby] = birth.mass;
+        m_store.velocity[baby] = birth.velocity;
     }
 
-    for (auto& entity : m_entities) {
+    for (auto& respawn : buffer.respawns) {
 
-        if (entity->isAlive()) {
-            entity->render(target);
+        RandomGen random(m_seed, respawn.id, m_tick, RandomPurpose::Respawn);
+
+        if (respawn.type == EntityType::Cell) {
+            Cell::create(*this, 1, DNA(random), randomWorldPoint(random));
+        }
+        else if (respawn.resourceType == type::Food) {
+            Food::create(*this, randomWorldPoint(random), random);
         }
     }
 
-    target.setView(textView);
-    target.draw(*m_debugText);
+    buffer.births.clear();
+    buffer.respawns.clear();
 }
 
-vec2f World::randomWorldPoint()
+void World::onDeath(u32 index, CommandBuffer& buffer)
 {
-    // Generate a random angle between 0 and 2(Pi).
-    const r32 theta = RandomGen::randomFloat(0.0f, Pi * 2.0f);
-    return vec2f(std::cos(theta) * RandomGen::randomFloat(0.0f, m_radius),
-                 std::sin(theta) * RandomGen::randomFloat(0.0f, m_radius));
+    if (m_store.type[index] == EntityType::Cell) {
+
+        // The cell update kills a cell that is out of food or mass, the food is checked first.
+        const bool starved = m_store.cells.foodAmount[m_store.component[index]] < 1.0f;
+        m_events.death(m_tick, m_store.id[index], starved ? event::Starved : event::Eaten);
+        m_lineage.death(m_tick, m_store.id[index]);
+
+        //std::stringstream sb;
+        //sb << "entity died at generation: " << m_store.cells.generation[m_store.component[index]];
+
+        //Console::write(sb.str());
+
+        // Count the cells waiting to be added too.
+        u32 cellCount = m_store.cells.size() + buffer.births.size();
+        for (auto& respawn : buffer.respawns) {
+            if (respawn.type == EntityType::Cell)
+                cellCount++;
+        }
+
+        if (cellCount <= 10) {
+            buffer.respawns.push_back({ m_store.id[index], EntityType::Cell, type::Food });
+        }
+    }
+    else if (m_store.type[index] == EntityType::Resource) {
+
+        const type::ResourceType resourceType = m_store.resources.resourceType[m_store.component[index]];
+
+        m_events.death(m_tick, m_store.id[index], event::Depleted);
+
+        if (resourceType == type::Food) {
+            buffer.respawns.push_back({ m_store.id[index], EntityType::Resource, resourceType });
+        }
+    }
 }
 
-void World::add(Entity* entity)
+void World::queryNear(u32 index, bool fullSearch, std::vector<u32>& list) const
 {
-    // Make sure there is never a null entity added.
-    if (entity == 0) {
-        return;
-    }
+    m_spatialGrid.query(index, fullSearch ? 2 : 1, list);
+}
 
-    m_entities.push_back(entity);
+vec2f World::randomWorldPoint(RandomGen& random)
+{
+    // Generate a random angle between 0 and 2(Pi).
+    const r32 theta = random.randomFloat(0.0f, Pi * 2.0f);
+    const r32 x = std::cos(theta) * random.randomFloat(0.0f, m_radius);
+    const r32 y = std::sin(theta) * random.randomFloat(0.0f, m_radius);
+    return vec2f(x, y);
 }
 
 bool World::isPointInWorld(vec2f point)
@@ -313,12 +495,12 @@ bool World::isPointInWorld(vec2f point)
     return (delta.x + delta.y <= m_radius * m_radius);
 }
 
-bool World::isEntityInWorld(Entity* entity)
+bool World::isEntityInWorld(u32 index)
 {
-    // Well a null entity can't exist in the world so ya..
-    if (entity == 0) {
+    // Well an entity that doesn't exist can't be in the world so ya..
+    if (index >= m_store.size()) {
         return false;
     }
 
-    return isPointInWorld(entity->getLocation());
+    return isPointInWorld(m_store.location[index]);
 }
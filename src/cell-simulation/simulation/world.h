@@ -2,24 +2,56 @@
 #define ECOSYSTEM_H_INCLUDE
 
 // Standard includes.
+#include <string>
 #include <vector>
 
-// SFML includes.
-#include <SFML/Graphics/RenderTarget.hpp>
-#include <SFML/Graphics/CircleShape.hpp>
-#include <SFML/Graphics/VertexArray.hpp>
-#include <SFML/Graphics/Text.hpp>
-
 #include <scl/types.h>
 
 // Project includes.
-#include "../core/camera.h"
-
 #include "neuralnetwork.h"
 #include "entity.h"
+#include "entitystore.h"
+#include "commandbuffer.h"
+#include "threadpool.h"
+#include "randomgen.h"
+#include "checkpointer.h"
+#include "eventstream.h"
+#include "lineage.h"
 
 #include "genetics/genome.h"
-#include "partitioning/spatialhash.h"
+#include "partitioning/spatialgrid.h"
+
+/**
+ * @brief Where the population is saved between runs.
+ */
+const std::string POPULATION_FILE_PATH = "../../data/population.bin";
+
+/**
+ * @brief The old text population file, only read when there is no binary file yet.
+ */
+const std::string LEGACY_POPULATION_FILE_PATH = "../../data/dna.dat";
+
+/**
+ * @brief Where the full world state is saved on exit, a resumed run carries on from it.
+ */
+const std::string SNAPSHOT_FILE_PATH = "../../data/snapshot.bin";
+
+/**
+ * @brief Where a profiler trace is written, it can be opened in chrome://tracing.
+ */
+const std::string TRACE_FILE_PATH = "../../data/trace.json";
+
+/**
+ * @brief The radius of the world when none is given.
+ */
+const r32 DEFAULT_WORLD_RADIUS = 2046.0f;
+
+/**
+ * @brief The number of each kind of entity a new world starts with.
+ */
+const u32 START_CELL_COUNT = 50;
+const u32 START_FIRE_COUNT = 50;
+const u32 START_FOOD_COUNT = 250;
 
 /**
  * @brief The world is responsible for managing the entities.
@@ -27,11 +59,13 @@
 class World
 {
 public:
+    friend class Snapshot;
 
     /**
      * @brief The default world constructor.
+     * @param radius = The radius of the world.
      */
-    World();
+    explicit World(r32 radius = DEFAULT_WORLD_RADIUS);
 
     /**
      * @brief The default world destructor.
@@ -40,36 +74,48 @@ public:
 
     /**
      * @brief Initialize the world and load any needed content.
+     * A fresh world is keyed with the seed it was given, a resumed one takes the seed of the run it carries on.
+     * @param resume = Carry on the newest run from its snapshot or checkpoints, if there is one.
      * @return True if sucessful.
      */
-    bool initialize();
+    bool initialize(bool resume);
 
     /**
      * @brief Destroy any loaded content.
      */
     void destroy();
 
+    /**
+     * @brief Save the dna of every cell to the population file.
+     */
     void saveState();
 
+    /**
+     * @brief Load the cells from the population file, or from the old text file if there isn't one yet.
+     */
     void loadState();
 
     /**
-     * @brief Update the world.
-     * @param dt = Delta time.
+     * @brief Add new random entities to the world and rebuild the spatial grid.
+     * Nothing is loaded or saved, the entities come from the world seed alone.
+     * @param cellCount = The number of new cells.
+     * @param fireCount = The number of new fires.
+     * @param foodCount = The number of new food resources.
      */
-    void update(const float dt);
+    void populate(u32 cellCount, u32 fireCount, u32 foodCount);
 
     /**
-     * @brief Render the world.
-     * @param target = Target to render to.
+     * @brief Update the world.
+     * @param dt = Delta time.
      */
-    void render(sf::RenderTarget& target, Camera& camera, const sf::View& textView);
+    void update(const float dt);
 
     /**
      * @brief Generate a random point that is within the world.
+     * @param random = The random stream to draw from.
      * @return The random point in the world.
      */
-    vec2f randomWorldPoint();
+    vec2f randomWorldPoint(RandomGen& random);
 
     /**
      * @brief Check if a point is in the world.
@@ -80,22 +126,58 @@ public:
 
     /**
      * @brief Check if the specified entity is in the world.
-     * @param entity = The entity to check.
+     * @param index = The dense index of the entity to check.
      * @return True if the entity is in the world.
      */
-    bool isEntityInWorld(Entity* entity);
+    bool isEntityInWorld(u32 index);
+
+    /**
+     * @brief Get the seed all of the random streams in the world are keyed with.
+     * @return The world seed.
+     */
+    u64 getSeed() const { return m_seed; }
+
+    /**
+     * @brief Set the seed all of the random streams in the world are keyed with.
+     * The same seed and starting state gives the same simulation no matter the thread count,
+     * as long as the network kernel is the same, see setKernel().
+     * @param seed = The world seed.
+     */
+    void setSeed(u64 seed) { m_seed = seed; }
+
+    /**
+     * @brief Get the number of updates run so far.
+     * @return The current tick.
+     */
+    u64 getTick() const { return m_tick; }
+
+    /**
+     * @brief Set how often a checkpoint of the world is written in the background.
+     * @param interval = The number of ticks between checkpoints, (0 for off)
+     * @param retention = The number of checkpoints to keep.
+     */
+    void setCheckpoints(u64 interval, u32 retention) {
+        m_checkpointer.setInterval(interval);
+        m_checkpointer.setRetention(retention);
+    }
 
     /**
-     * @brief Enable or disable the debug data.
-     * @param debug = The new debug state.
+     * @brief Get the background checkpointer, used to report the checkpoint stats.
+     * @return The checkpointer.
      */
-    void setDebug(bool debug) { m_debug = debug; }
+    const Checkpointer& getCheckpointer() const { return m_checkpointer; }
 
     /**
-     * @brief Get the current debugging state of the world.
-     * @return The current debugging state.
+     * @brief Get the stream the population events are recorded into, it is closed until it is opened.
+     * @return The event stream.
      */
-    bool getDebug() const { return m_debug; }
+    EventStream& getEvents() { return m_events; }
+
+    /**
+     * @brief Get the family tree of the cells.
+     * @return The lineage.
+     */
+    Lineage& getLineage() { return m_lineage; }
 
     /**
      * @brief Get the worlds current radius.
@@ -107,32 +189,71 @@ public:
      * @brief Get the current count of the entities.
      * @return The current entity count.
      */
-    u32 getEntityCount() const { return m_entities.size(); }
+    u32 getEntityCount() const { return m_store.size(); }
+
+    /**
+     * @brief Get the current count of the cells.
+     * @return The current cell count.
+     */
+    u32 getCellCount() const { return m_store.cells.size(); }
+
+    /**
+     * @brief Get the store that holds all of the entity data.
+     * @return A reference to the entity store.
+     */
+    EntityStore& getStore() { return m_store; }
+
+    /**
+     * @brief Get the store that holds all of the entity data.
+     * @return A const reference to the entity store.
+     */
+    const EntityStore& getStore() const { return m_store; }
+
+    /**
+     * @brief Get a reference to the spatial grid.
+     * @return A const reference to the spatial grid.
+     */
+    const SpatialGrid& getSpatialGrid() const { return m_spatialGrid; }
+
+    /**
+     * @brief Get the number of threads the update is split across.
+     * @return The number of threads including the calling thread.
+     */
+    u32 getThreadCount() const { return m_threadPool->getWorkerCount(); }
 
     /**
-     * @brief Get an entity by the specified index. (undefined behavior for out of range indexes)
-     * @param index = The index to get the entity of.
-     * @return The entity at that index.
+     * @brief Select the kernel the cell networks are evaluated with by name.
+     * The kernels round differently, so a run is only reproduced on the same kernel, "scalar" is the same on every cpu.
+     * @param name = The name of the kernel, "auto" for the fastest one the cpu supports.
+     * @return True if the kernel is known and supported.
      */
-    Entity* getEntity(u32 index) { return m_entities[index]; }
+    bool setKernel(const std::string& name);
 
     /**
-     * @brief Get the entity list for the world.
-     * @return A reference to the world entity list.
+     * @brief Set the number of threads the update is split across.
+     * @param threadCount = The number of threads including the calling thread, (0 for one per core)
      */
-    std::vector<Entity*>& getEntities() { return m_entities; }
+    void setThreadCount(u32 threadCount);
 
     /**
-     * @brief Get a reference to the spatial hash.
-     * @return A reference to the spatial hash.
+     * @brief Find the entities that are close to an entity.
+     * @param index = The dense index of the entity.
+     * @param fullSearch = Search the 5x5 block of cells around the entity instead of the 3x3 block.
+     * @param list = The list to add the dense indices of the near entities to.
      */
-    SpatialHash& getSpatialHash() { return m_spatialHash; }
+    void queryNear(u32 index, bool fullSearch, std::vector<u32>& list) const;
 
     /**
-     * @brief Add an enitity into the world.
-     * @param entity = The entity to add into the world.
+     * @brief Call a function for each entity close to an entity, without building a list.
+     * @param index = The dense index of the entity.
+     * @param fullSearch = Search the 5x5 block of cells around the entity instead of the 3x3 block.
+     * @param visit = The function to call with the dense index of each near entity.
      */
-    void add(Entity* entity);
+    template <typename Visitor>
+    void forEachNear(u32 index, bool fullSearch, Visitor&& visit) const
+    {
+        m_spatialGrid.forEachNear(index, fullSearch ? 2 : 1, visit);
+    }
 
     /**
      * @brief The neural network used for the cells processing.
@@ -147,9 +268,9 @@ public:
 private:
 
     /**
-     * @brief Show the debug grid or not.
+     * @brief Load the cells from the old text population file.
      */
-    bool m_debug;
+    void loadLegacyState();
 
     /**
      * @brief The radius of the world.
@@ -157,45 +278,132 @@ private:
     r32 m_radius;
 
     /**
-     * @brief Used to render the border of the world.
+     * @brief The seed all of the random streams in the world are keyed with.
+     */
+    u64 m_seed;
+
+    /**
+     * @brief The number of updates run so far.
+     */
+    u64 m_tick;
+
+    /**
+     * @brief The tick the run was started fresh at, part of the identity of the run.
+     */
+    u64 m_runStartTick;
+
+    /**
+     * @brief The system time the run was started fresh at in nanoseconds, part of the identity of the run.
+     */
+    u64 m_runStartTime;
+
+    /**
+     * @brief All of the entities in the world.
+     */
+    EntityStore m_store;
+
+    /**
+     * @brief The spatial grid used to speed up the neighbour queries.
+     */
+    SpatialGrid m_spatialGrid;
+
+    /**
+     * @brief Writes the periodic checkpoints in the background.
+     */
+    Checkpointer m_checkpointer;
+
+    /**
+     * @brief Records the births, deaths, consumption and collisions.
+     */
+    EventStream m_events;
+
+    /**
+     * @brief The ancestry of the living cells.
      */
-    sf::CircleShape m_border;
+    Lineage m_lineage;
 
     /**
-     * @brief The vertex array used for debug rendering.
+     * @brief The threads the parallel phases of the update are run on.
      */
-    sf::VertexArray m_vertexQuadArray;
+    std::unique_ptr<ThreadPool> m_threadPool;
 
     /**
-     * @brief The vertex array used for debug rendering.
+     * @brief The command buffer of each worker in the thread pool.
      */
-    sf::VertexArray m_vertexLineArray;
+    std::vector<CommandBuffer> m_commandBuffers;
 
     /**
-     * @brief The text used to render some special debug information.
+     * @brief The packed network inputs of every cell, rebuilt each update.
      */
-    sf::Text* m_debugText;
+    std::vector<r32> m_networkInputs;
 
     /**
-     * @brief A list of all the active entities in the world.
+     * @brief The packed network outputs of every cell, rebuilt each update.
+     */
+    std::vector<r32> m_networkOutputs;
+
+    /**
+     * @brief The genome weights of every cell, pointing straight at the genome data.
+     */
+    std::vector<const r32*> m_networkWeights;
+
+    /**
+     * @brief Sense the surroundings of the cells and gather the network inputs, runs in parallel.
+     */
+    void sense();
+
+    /**
+     * @brief Run the networks of the cells in batches and steer them with the outputs, runs in parallel.
+     * @param dt = Delta time.
+     */
+    void think(const float dt);
+
+    /**
+     * @brief Drain and resize the resources, runs in parallel.
+     * @param dt = Delta time.
+     */
+    void updateResources(const float dt);
+
+    /**
+     * @brief Move the entities, runs in parallel.
+     * @param dt = Delta time.
+     */
+    void integrate(const float dt);
+
+    /**
+     * @brief Find the touching entities in parallel and then resolve the collisions in order.
+     */
+    void collide();
+
+    /**
+     * @brief Rebuild the spatial grid from the current entity locations.
+     */
+    void rebuildIndex();
+
+    /**
+     * @brief Split the cells that are ready, remove the dead entities and then add the new ones.
+     * @param dt = Delta time.
      */
-    std::vector<Entity*> m_entities;
+    void spawn(const float dt);
 
     /**
-     * @brief The spatial hash used to speed up collision checks.
+     * @brief Occurs when an entity dies in the world, records the death and its replacement if it needs one.
+     * @param index = The dense index of the entity that died.
+     * @param buffer = The command buffer to record the replacement into.
      */
-    SpatialHash m_spatialHash;
+    void onDeath(u32 index, CommandBuffer& buffer);
 
     /**
-     * @brief Occurs when an entity dies in the world.
-     * @param entity = The entity that dies.
+     * @brief Remove the dead entities from the store, each one is swapped with the last entity.
+     * @param buffer = The command buffer to record the replacements into.
      */
-    void onDeath(Entity* entity);
+    void removeDead(CommandBuffer& buffer);
 
     /**
-     * @brief Update the entity debug text label.
+     * @brief Add the cells born this tick and the replacements for the entities that died.
+     * @param buffer = The command buffer holding the births and the replacements.
      */
-    void updateEntityText();
+    void applyBirths(CommandBuffer& buffer);
 };
 
 #endif // ECOSYSTEM_H_INCLUDE